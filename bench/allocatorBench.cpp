@@ -0,0 +1,80 @@
+#include <cstdlib>
+#include <iostream>
+#include "Allocator.hpp"
+#include "Memory.hpp"
+#include "Vector.hpp"
+#include "Profiler.hpp"
+
+using namespace std;
+
+struct Node {
+    int key;
+    double weight;
+    Node* next;
+    Node(int k, Node* n) : key(k), weight(0.0), next(n) {}
+};
+
+// build and tear down a linked list one node at a time
+template <typename Alloc>
+double nodeChurn(Alloc alloc, size_t n, int rounds) {
+    Profiler::start();
+    for (int r = 0; r < rounds; r++) {
+        Node* head = nullptr;
+        for (size_t i = 0; i < n; i++) {
+            Node* p = alloc.allocate(1);
+            alloc.construct(p, (int)i, head);
+            head = p;
+        }
+        while (head != nullptr) {
+            Node* next = head->next;
+            alloc.destroy(head);
+            alloc.deallocate(head, 1);
+            head = next;
+        }
+    }
+    Profiler::stop();
+    return double(n) * rounds / Profiler::second() / 1e6;
+}
+
+// many short-lived small vectors, as in per-request scratch buffers
+template <typename Alloc>
+double vectorChurn(Alloc alloc, size_t n) {
+    long long sum = 0;
+    Profiler::start();
+    for (size_t i = 0; i < n; i++) {
+        TinySTL::vector<int, Alloc> vec(alloc);
+        for (int j = 0; j < 12; j++) {
+            vec.push_back(j);
+        }
+        sum += vec.back();
+    }
+    Profiler::stop();
+    if (sum == 0) {
+        cout << "";
+    }
+    return double(n) / Profiler::second() / 1e6;
+}
+
+int main(int argc, char* argv[]) {
+    size_t n = argc > 1 ? strtoul(argv[1], NULL, 10) : 1000000;
+    const int rounds = 10;
+
+    cout << "node allocate/deallocate (M nodes/s), " << n << " nodes x " << rounds << endl;
+    cout << "allocator:\t\t" << nodeChurn(TinySTL::allocator<Node>(), n, rounds) << endl;
+    cout << "pool_allocator:\t\t" << nodeChurn(TinySTL::pool_allocator<Node>(), n, rounds) << endl;
+    cout << "thread_cache_allocator:\t" << nodeChurn(TinySTL::thread_cache_allocator<Node>(), n, rounds) << endl;
+    {
+        TinySTL::monotonic_arena arena(1 << 20);
+        cout << "arena_allocator:\t" << nodeChurn(TinySTL::arena_allocator<Node>(arena), n, rounds) << endl;
+    }
+
+    cout << "small vector churn (M vectors/s), " << n << " vectors" << endl;
+    cout << "allocator:\t\t" << vectorChurn(TinySTL::allocator<int>(), n) << endl;
+    cout << "pool_allocator:\t\t" << vectorChurn(TinySTL::pool_allocator<int>(), n) << endl;
+    cout << "thread_cache_allocator:\t" << vectorChurn(TinySTL::thread_cache_allocator<int>(), n) << endl;
+    {
+        TinySTL::monotonic_arena arena(1 << 20);
+        cout << "arena_allocator:\t" << vectorChurn(TinySTL::arena_allocator<int>(arena), n) << endl;
+    }
+    return 0;
+}
@@ -0,0 +1,100 @@
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include "ConcurrentQueue.hpp"
+#include "Vector.hpp"
+#include "Profiler.hpp"
+
+using namespace std;
+
+// moves items through the queue from producers to consumers, batch items
+// per call (batch == 1 uses try_push/try_pop)
+template <typename Queue>
+void run(const char* name, Queue& queue, int producers, int consumers,
+         size_t items, size_t batch) {
+    size_t perProducer = items / producers;
+    size_t total = perProducer * producers;
+    atomic<size_t> popped(0);
+    atomic<long long> sum(0);
+
+    Profiler::start();
+    TinySTL::vector<thread*> threads;
+    for (int p = 0; p < producers; p++) {
+        threads.push_back(new thread([&] {
+            TinySTL::vector<long long> buf(batch);
+            for (size_t i = 0; i < perProducer; i += batch) {
+                size_t n = perProducer - i < batch ? perProducer - i : batch;
+                if (batch == 1) {
+                    while (!queue.try_push((long long)i)) {
+                        this_thread::yield();
+                    }
+                    continue;
+                }
+                for (size_t j = 0; j < n; j++) {
+                    buf[j] = (long long)(i + j);
+                }
+                long long* first = &buf[0];
+                while (first != &buf[0] + n) {
+                    size_t pushed = queue.push_batch(first, &buf[0] + n);
+                    if (pushed == 0) {
+                        this_thread::yield();
+                    }
+                    first += pushed;
+                }
+            }
+        }));
+    }
+    for (int c = 0; c < consumers; c++) {
+        threads.push_back(new thread([&] {
+            TinySTL::vector<long long> buf(batch);
+            long long local = 0;
+            while (popped.load(memory_order_relaxed) < total) {
+                size_t n;
+                if (batch == 1) {
+                    n = queue.try_pop(buf[0]) ? 1 : 0;
+                } else {
+                    n = queue.pop_batch(&buf[0], batch);
+                }
+                for (size_t j = 0; j < n; j++) {
+                    local += buf[j];
+                }
+                if (n != 0) {
+                    popped.fetch_add(n, memory_order_relaxed);
+                } else {
+                    // the queue is empty: let producers run when threads
+                    // outnumber cores
+                    this_thread::yield();
+                }
+            }
+            sum += local;
+        }));
+    }
+    for (size_t i = 0; i < threads.size(); i++) {
+        threads[i]->join();
+        delete threads[i];
+    }
+    Profiler::stop();
+    cout << name << "\t" << producers << "P/" << consumers << "C\tbatch: " << batch << "\t"
+         << total / Profiler::second() / 1e6 << " Mitems/s" << (sum < 0 ? "!" : "") << endl;
+}
+
+int main(int argc, char* argv[]) {
+    size_t items = argc > 1 ? strtoul(argv[1], NULL, 10) : 20000000;
+    int maxThreads = argc > 2 ? atoi(argv[2]) : (int)thread::hardware_concurrency();
+    if (maxThreads < 2) {
+        maxThreads = 2;
+    }
+
+    for (size_t batch = 1; batch <= 64; batch *= 8) {
+        TinySTL::spsc_queue<long long> spsc(4096);
+        run("spsc_queue", spsc, 1, 1, items, batch);
+    }
+    for (int pairs = 1; 2 * pairs <= maxThreads; pairs *= 2) {
+        for (size_t batch = 1; batch <= 64; batch *= 8) {
+            TinySTL::mpmc_queue<long long> mpmc(4096);
+            run("mpmc_queue", mpmc, pairs, pairs, items, batch);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,48 @@
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <utility>
+#include "ConcurrentUFSet.hpp"
+#include "UFSet.hpp"
+#include "Vector.hpp"
+#include "Profiler.hpp"
+
+using namespace std;
+
+int main(int argc, char* argv[]) {
+    int n = argc > 1 ? atoi(argv[1]) : (1 << 22);
+    size_t m = argc > 2 ? strtoul(argv[2], NULL, 10) : 4 * (size_t)n;
+    unsigned maxThreads = argc > 3 ? (unsigned)atoi(argv[3]) : thread::hardware_concurrency();
+
+    // uniform random graph G(n, m)
+    TinySTL::vector<pair<int, int>> edges;
+    edges.reserve(m);
+    mt19937 gen(42);
+    uniform_int_distribution<int> vertex(0, n - 1);
+    for (size_t i = 0; i < m; i++) {
+        edges.push_back(make_pair(vertex(gen), vertex(gen)));
+    }
+    cout << n << " vertices, " << m << " edges" << endl;
+
+    {
+        TinySTL::UFSet sets(n);
+        Profiler::start();
+        for (size_t i = 0; i < m; i++) {
+            sets.Union(edges[i].first, edges[i].second);
+        }
+        Profiler::stop();
+        cout << "UFSet          \t1 thread(s)\t" << Profiler::millisecond() << " milliseconds" << endl;
+    }
+    for (unsigned threads = 1; threads <= maxThreads; threads *= 2) {
+        TinySTL::ConcurrentUFSet sets(n);
+        Profiler::start();
+        sets.unionAll(edges.begin(), edges.end(), threads);
+        Profiler::stop();
+        cout << "ConcurrentUFSet\t" << threads << " thread(s)\t" << Profiler::millisecond() << " milliseconds" << endl;
+        if (threads < maxThreads && threads * 2 > maxThreads) {
+            threads = maxThreads / 2;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,43 @@
+#include <cstdlib>
+#include <deque>
+#include <iostream>
+#include "Deque.hpp"
+#include "Vector.hpp"
+#include "Profiler.hpp"
+
+using namespace std;
+
+// FIFO queue: push at the back, pop at the front, keeping about window
+// elements alive
+template <typename Queue, typename PopFront>
+void run(const char* name, size_t ops, size_t window, PopFront popFront) {
+    Queue queue;
+    long long sum = 0;
+    Profiler::start();
+    for (size_t i = 0; i < ops; i++) {
+        queue.push_back((int)i);
+        if (queue.size() > window) {
+            sum += queue.front();
+            popFront(queue);
+        }
+    }
+    Profiler::stop();
+    cout << name << "\twindow: " << window << "\t"
+         << Profiler::millisecond() << " milliseconds" << (sum < 0 ? "!" : "") << endl;
+}
+
+int main(int argc, char* argv[]) {
+    size_t ops = argc > 1 ? strtoul(argv[1], NULL, 10) : 10000000;
+    for (size_t window = 16; window <= 16384; window *= 32) {
+        run<TinySTL::deque<int>>("TinySTL::deque ", ops, window,
+                                 [](TinySTL::deque<int>& q) { q.pop_front(); });
+        run<std::deque<int>>("std::deque     ", ops, window,
+                             [](std::deque<int>& q) { q.pop_front(); });
+        // a vector has no pop_front: erase(begin()) shifts the whole window
+        if (window <= 512) {
+            run<TinySTL::vector<int>>("TinySTL::vector", ops, window,
+                                      [](TinySTL::vector<int>& q) { q.erase(q.begin()); });
+        }
+    }
+    return 0;
+}
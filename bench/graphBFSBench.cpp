@@ -0,0 +1,119 @@
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <unordered_set>
+#include "GraphAdj.hpp"
+#include "GraphCSR.hpp"
+#include "Vector.hpp"
+#include "Profiler.hpp"
+
+using namespace std;
+
+// BFS through the virtual getFirstNeighbour/getNextNeighbour interface
+template <typename Graph>
+size_t bfsVirtual(Graph& g, int source, TinySTL::vector<int>& dist) {
+    dist.assign(g.numOfVertices(), -1);
+    TinySTL::vector<int> queue;
+    queue.reserve(g.numOfVertices());
+    dist[source] = 0;
+    queue.push_back(source);
+    for (size_t head = 0; head < queue.size(); head++) {
+        int v = queue[head];
+        for (int u = g.getFirstNeighbour(v); u != -1; u = g.getNextNeighbour(v, u)) {
+            if (dist[u] == -1) {
+                dist[u] = dist[v] + 1;
+                queue.push_back(u);
+            }
+        }
+    }
+    return queue.size();
+}
+
+// BFS over the neighbours() ranges
+template <typename Graph>
+size_t bfsRange(const Graph& g, int source, TinySTL::vector<int>& dist) {
+    dist.assign(g.numOfVertices(), -1);
+    TinySTL::vector<int> queue;
+    queue.reserve(g.numOfVertices());
+    dist[source] = 0;
+    queue.push_back(source);
+    for (size_t head = 0; head < queue.size(); head++) {
+        int v = queue[head];
+        for (const auto& e : g.neighbours(v)) {
+            if (dist[e.dest] == -1) {
+                dist[e.dest] = dist[v] + 1;
+                queue.push_back(e.dest);
+            }
+        }
+    }
+    return queue.size();
+}
+
+int main(int argc, char* argv[]) {
+    int n = argc > 1 ? atoi(argv[1]) : 1000000;
+    size_t m = argc > 2 ? strtoul(argv[2], NULL, 10) : 10000000;
+
+    // uniform random directed graph G(n, m) without parallel edges:
+    // getNextNeighbour(v, u) cannot step past a repeated u
+    TinySTL::vector<TinySTL::WeightedEdge<int> > edges;
+    edges.reserve(m);
+    unordered_set<unsigned long long> seen;
+    mt19937 gen(42);
+    uniform_int_distribution<int> vertex(0, n - 1);
+    while (edges.size() < m) {
+        int src = vertex(gen), dest = vertex(gen);
+        if (seen.insert((unsigned long long)src * n + dest).second) {
+            edges.push_back(TinySTL::WeightedEdge<int>(src, dest, 1));
+        }
+    }
+    seen.clear();
+    TinySTL::vector<int> values;
+    for (int i = 0; i < n; i++) {
+        values.push_back(i);
+    }
+    cout << n << " vertices, " << m << " edges" << endl;
+
+    TinySTL::GraphAdj<int> adj;
+    Profiler::start();
+    for (int i = 0; i < n; i++) {
+        adj.insertVertex(i);
+    }
+    for (size_t i = 0; i < m; i++) {
+        adj.insertEdge(edges[i].src, edges[i].dest, edges[i].weight);
+    }
+    Profiler::stop();
+    cout << "build GraphAdj              \t" << Profiler::millisecond() << " milliseconds" << endl;
+
+    Profiler::start();
+    TinySTL::GraphCSR<int> fromAdj(adj);
+    Profiler::stop();
+    cout << "build GraphCSR from GraphAdj\t" << Profiler::millisecond() << " milliseconds" << endl;
+
+    Profiler::start();
+    TinySTL::GraphCSR<int> csr(values, edges);
+    Profiler::stop();
+    cout << "build GraphCSR from edges   \t" << Profiler::millisecond() << " milliseconds" << endl;
+
+    TinySTL::vector<int> dist;
+    size_t reached;
+    Profiler::start();
+    reached = bfsVirtual(adj, 0, dist);
+    Profiler::stop();
+    cout << "BFS GraphAdj (getNextNeighbour)\t" << Profiler::millisecond() << " milliseconds\treached " << reached << endl;
+
+    Profiler::start();
+    reached = bfsRange(adj, 0, dist);
+    Profiler::stop();
+    cout << "BFS GraphAdj (neighbours)      \t" << Profiler::millisecond() << " milliseconds\treached " << reached << endl;
+
+    Profiler::start();
+    reached = bfsVirtual(csr, 0, dist);
+    Profiler::stop();
+    cout << "BFS GraphCSR (getNextNeighbour)\t" << Profiler::millisecond() << " milliseconds\treached " << reached << endl;
+
+    Profiler::start();
+    reached = bfsRange(csr, 0, dist);
+    Profiler::stop();
+    cout << "BFS GraphCSR (neighbours)      \t" << Profiler::millisecond() << " milliseconds\treached " << reached << endl;
+    return 0;
+}
@@ -0,0 +1,80 @@
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include "GraphBFS.hpp"
+#include "GraphCSR.hpp"
+#include "Vector.hpp"
+#include "Profiler.hpp"
+
+using namespace std;
+
+// R-MAT generator (Chakrabarti et al.) with the Graph500 parameters
+// a = 0.57, b = 0.19, c = 0.19: 2^scale vertices, edgeFactor * 2^scale
+// edges, a skewed degree distribution and a small diameter
+TinySTL::vector<TinySTL::WeightedEdge<int> > rmat(int scale, int edgeFactor, unsigned seed) {
+    const double a = 0.57, b = 0.19, c = 0.19;
+    size_t m = (size_t)edgeFactor << scale;
+    TinySTL::vector<TinySTL::WeightedEdge<int> > edges;
+    edges.reserve(m);
+    mt19937 gen(seed);
+    uniform_real_distribution<double> uniform(0.0, 1.0);
+    for (size_t i = 0; i < m; i++) {
+        int src = 0, dest = 0;
+        for (int bit = 0; bit < scale; bit++) {
+            double r = uniform(gen);
+            if (r < a) {
+            } else if (r < a + b) {
+                dest |= 1 << bit;
+            } else if (r < a + b + c) {
+                src |= 1 << bit;
+            } else {
+                src |= 1 << bit;
+                dest |= 1 << bit;
+            }
+        }
+        edges.push_back(TinySTL::WeightedEdge<int>(src, dest, 1));
+    }
+    return edges;
+}
+
+int main(int argc, char* argv[]) {
+    int scale = argc > 1 ? atoi(argv[1]) : 20;
+    int edgeFactor = argc > 2 ? atoi(argv[2]) : 16;
+    unsigned maxThreads = argc > 3 ? (unsigned)atoi(argv[3]) : TinySTL::defaultThreads();
+    int searches = 8;
+
+    TinySTL::vector<TinySTL::WeightedEdge<int> > edges = rmat(scale, edgeFactor, 1);
+    TinySTL::vector<int> values(1 << scale, 0);
+    TinySTL::GraphCSR<int> g(values, edges);
+    cout << "R-MAT scale " << scale << ": " << g.numOfVertices() << " vertices, "
+         << g.numOfEdges() << " edges" << endl;
+
+    Profiler::start();
+    TinySTL::ParallelBFS<TinySTL::GraphCSR<int> > bfs(g);
+    Profiler::stop();
+    cout << "build transpose\t" << Profiler::millisecond() << " milliseconds" << endl;
+
+    // search from the highest-degree vertices so every run covers the
+    // giant component
+    TinySTL::vector<int> sources;
+    for (int v = 0; (int)sources.size() < searches && v < (int)g.numOfVertices(); v++) {
+        if (g.getOutDegree(v) > (size_t)edgeFactor) {
+            sources.push_back(v);
+        }
+    }
+
+    for (int opt = 0; opt < 2; opt++) {
+        for (unsigned threads = 1; threads <= maxThreads; threads *= 2) {
+            size_t reached = 0;
+            Profiler::start();
+            for (size_t i = 0; i < sources.size(); i++) {
+                reached += bfs.run(sources[i], threads, opt == 1).reached;
+            }
+            Profiler::stop();
+            cout << (opt ? "direction-optimizing" : "top-down only       ") << "\t" << threads
+                 << " thread(s)\t" << Profiler::millisecond() / sources.size()
+                 << " milliseconds per search\treached " << reached / sources.size() << endl;
+        }
+    }
+    return 0;
+}
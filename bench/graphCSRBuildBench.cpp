@@ -0,0 +1,62 @@
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include "GraphAdj.hpp"
+#include "GraphCSR.hpp"
+#include "Parallel.hpp"
+#include "Profiler.hpp"
+
+using namespace std;
+
+typedef TinySTL::GraphCSR<int, int> CSR;
+
+template <typename Build>
+void run(const char* name, size_t edges, Build build) {
+    Profiler::start();
+    size_t m = build();
+    Profiler::stop();
+    cout << name << "\tedges: " << m << "\t" << Profiler::millisecond() << " milliseconds\t"
+         << edges / Profiler::second() / 1e6 << " M input edges/s" << endl;
+}
+
+int main(int argc, char* argv[]) {
+    size_t edges = argc > 1 ? strtoul(argv[1], NULL, 10) : 50000000;
+    unsigned maxThreads = argc > 2 ? strtoul(argv[2], NULL, 10) : TinySTL::defaultThreads();
+    size_t vertices = edges / 16;
+
+    mt19937 gen(1);
+    uniform_int_distribution<int> pick(0, vertices - 1);
+    TinySTL::vector<int> values(vertices);
+    for (size_t i = 0; i < vertices; i++) {
+        values[i] = i;
+    }
+    TinySTL::vector<TinySTL::WeightedEdge<int> > list(edges);
+    for (size_t i = 0; i < edges; i++) {
+        list[i] = TinySTL::WeightedEdge<int>(pick(gen), pick(gen), i & 255);
+    }
+
+    // the serial baseline: one insertEdge per edge
+    run("GraphAdj insertEdge     ", edges, [&]() {
+        TinySTL::GraphAdj<int, int> g;
+        for (size_t i = 0; i < vertices; i++) {
+            g.insertVertex(i);
+        }
+        for (size_t i = 0; i < edges; i++) {
+            g.insertEdge(list[i].src, list[i].dest, list[i].weight);
+        }
+        return g.numOfEdges();
+    });
+    for (unsigned threads = 1; threads <= maxThreads; threads *= 2) {
+        cout << "threads: " << threads << endl;
+        run("GraphCSR                ", edges, [&]() {
+            return CSR(values, list, threads).numOfEdges();
+        });
+        run("GraphCSR, sorted        ", edges, [&]() {
+            return CSR(values, list, threads, CSR::SortNeighbours).numOfEdges();
+        });
+        run("GraphCSR, deduplicated  ", edges, [&]() {
+            return CSR(values, list, threads, CSR::Deduplicate).numOfEdges();
+        });
+    }
+    return 0;
+}
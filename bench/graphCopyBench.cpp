@@ -0,0 +1,62 @@
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include "GraphAdj.hpp"
+#include "Profiler.hpp"
+
+using namespace std;
+
+typedef TinySTL::GraphAdj<int, int> Graph;
+
+void report(const char* what, size_t edges) {
+    cout << what << "\tedges: " << edges << "\t" << Profiler::millisecond() << " milliseconds"
+         << endl;
+}
+
+int main(int argc, char* argv[]) {
+    size_t edges = argc > 1 ? strtoul(argv[1], NULL, 10) : 100000000;
+    size_t vertices = edges / 8;
+    mt19937 gen(1);
+    uniform_int_distribution<int> pick(0, vertices - 1);
+
+    Graph* g = new Graph();
+    Profiler::start();
+    for (size_t i = 0; i < vertices; i++) {
+        g->insertVertex(i);
+    }
+    for (size_t i = 0; i < edges; i++) {
+        g->insertEdge(pick(gen), pick(gen), i);
+    }
+    Profiler::stop();
+    report("build  ", edges);
+
+    Profiler::start();
+    Graph* copy = new Graph(*g);
+    Profiler::stop();
+    report("copy   ", edges);
+
+    Profiler::start();
+    g->reverse();
+    Profiler::stop();
+    report("reverse", edges);
+
+    Profiler::start();
+    delete g;
+    Profiler::stop();
+    report("destroy", edges);
+    delete copy;
+
+    // what the same number of nodes costs through new/delete one by one
+    TinySTL::Edge<int, int>** nodes = new TinySTL::Edge<int, int>*[edges];
+    Profiler::start();
+    for (size_t i = 0; i < edges; i++) {
+        nodes[i] = new TinySTL::Edge<int, int>(i, i);
+    }
+    for (size_t i = 0; i < edges; i++) {
+        delete nodes[i];
+    }
+    Profiler::stop();
+    report("new+delete per edge", edges);
+    delete[] nodes;
+    return 0;
+}
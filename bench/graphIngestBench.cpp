@@ -0,0 +1,51 @@
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include "GraphAdj.hpp"
+#include "Vector.hpp"
+#include "Profiler.hpp"
+
+using namespace std;
+
+// Build a graph from an edge list keyed by external 64-bit ids: look up
+// both endpoints, inserting unseen ones, then insert the edge.
+void ingest(const char* name, const TinySTL::vector<uint64_t>& ids, size_t edges, bool indexed) {
+    mt19937 gen(1);
+    uniform_int_distribution<size_t> pick(0, ids.size() - 1);
+    TinySTL::GraphAdj<uint64_t> g;
+    g.enableVertexIndex(indexed);
+    Profiler::start();
+    for (size_t i = 0; i < edges; i++) {
+        uint64_t endpoint[2] = {ids[pick(gen)], ids[pick(gen)]};
+        int pos[2];
+        for (int k = 0; k < 2; k++) {
+            pos[k] = g.getVertexPos(endpoint[k]);
+            if (pos[k] == -1) {
+                g.insertVertex(endpoint[k]);
+                pos[k] = g.numOfVertices() - 1;
+            }
+        }
+        g.insertEdge(pos[0], pos[1]);
+    }
+    Profiler::stop();
+    cout << name << "\tvertices: " << g.numOfVertices() << "\tedges: " << g.numOfEdges() << "\t"
+         << Profiler::millisecond() << " milliseconds" << endl;
+}
+
+int main(int argc, char* argv[]) {
+    size_t maxEdges = argc > 1 ? strtoul(argv[1], NULL, 10) : 50000000;
+    mt19937_64 gen(42);
+    for (size_t edges = 10000; edges <= maxEdges; edges *= 10) {
+        TinySTL::vector<uint64_t> ids(edges / 5);
+        for (size_t i = 0; i < ids.size(); i++) {
+            ids[i] = gen();
+        }
+        ingest("indexed", ids, edges, true);
+        // the scan is O(V) per lookup: only run it while that is bearable
+        if (edges <= 100000) {
+            ingest("scan   ", ids, edges, false);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,38 @@
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include "GraphAdj.hpp"
+#include "Profiler.hpp"
+
+using namespace std;
+
+// vertex-removal churn: a random graph with average out-degree 4 loses
+// random vertices one at a time
+void churn(const char* name, size_t vertices, size_t removals, bool bidirectional) {
+    mt19937 gen(1);
+    TinySTL::GraphAdj<int> g;
+    g.enableInEdges(bidirectional);
+    for (size_t i = 0; i < vertices; i++) {
+        g.insertVertex(i);
+    }
+    uniform_int_distribution<int> pick(0, vertices - 1);
+    for (size_t i = 0; i < 4 * vertices; i++) {
+        g.insertEdge(pick(gen), pick(gen));
+    }
+    Profiler::start();
+    for (size_t i = 0; i < removals; i++) {
+        g.removeVertex(gen() % g.numOfVertices());
+    }
+    Profiler::stop();
+    cout << name << "\tvertices: " << vertices << "\tremovals: " << removals << "\t"
+         << Profiler::millisecond() << " milliseconds\tedges left: " << g.numOfEdges() << endl;
+}
+
+int main(int argc, char* argv[]) {
+    size_t vertices = argc > 1 ? strtoul(argv[1], NULL, 10) : 1000000;
+    size_t removals = argc > 2 ? strtoul(argv[2], NULL, 10) : vertices / 2;
+    churn("in-edge lists", vertices, removals, true);
+    // every removal scans all lists: keep the count bearable
+    churn("out-edges only", vertices, removals < 100 ? removals : 100, false);
+    return 0;
+}
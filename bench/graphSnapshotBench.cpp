@@ -0,0 +1,89 @@
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unistd.h>
+#include "GraphAdj.hpp"
+#include "GraphSnapshot.hpp"
+#include "Profiler.hpp"
+
+using namespace std;
+
+// Cold start: rebuild a GraphAdj from a text edge list versus mapping a
+// binary snapshot, each followed by one pass over every edge.
+template <typename G>
+long long touchAll(const G& g) {
+    long long sum = 0;
+    for (size_t v = 0; v < g.numOfVertices(); v++) {
+        for (const auto& e : g.neighbours(v)) {
+            sum += e.dest + e.weight;
+        }
+    }
+    return sum;
+}
+
+int main(int argc, char* argv[]) {
+    size_t edges = argc > 1 ? strtoul(argv[1], NULL, 10) : 10000000;
+    size_t vertices = edges / 8;
+    string text = "/tmp/graphSnapshotBench.txt." + to_string(getpid());
+    string snapshot = "/tmp/graphSnapshotBench.bin." + to_string(getpid());
+
+    mt19937 gen(1);
+    uniform_int_distribution<int> pick(0, vertices - 1);
+    {
+        ofstream out(text);
+        out << vertices << "\n";
+        for (size_t i = 0; i < edges; i++) {
+            out << pick(gen) << " " << pick(gen) << " " << i % 100 << "\n";
+        }
+    }
+
+    Profiler::start();
+    TinySTL::GraphAdj<int, int> g;
+    {
+        ifstream in(text);
+        size_t n;
+        in >> n;
+        for (size_t i = 0; i < n; i++) {
+            g.insertVertex(i);
+        }
+        int src, dest, weight;
+        while (in >> src >> dest >> weight) {
+            g.insertEdge(src, dest, weight);
+        }
+    }
+    long long sum = touchAll(g);
+    Profiler::stop();
+    cout << "text load + scan    \tedges: " << g.numOfEdges() << "\t" << Profiler::millisecond()
+         << " milliseconds" << endl;
+
+    Profiler::start();
+    TinySTL::writeGraphSnapshot(g, snapshot);
+    Profiler::stop();
+    cout << "snapshot write      \tedges: " << g.numOfEdges() << "\t" << Profiler::millisecond()
+         << " milliseconds" << endl;
+
+    Profiler::start();
+    {
+        TinySTL::MappedGraph<int, int> verified(snapshot);
+        Profiler::stop();
+        cout << "snapshot open+verify\tedges: " << verified.numOfEdges() << "\t"
+             << Profiler::millisecond() << " milliseconds" << endl;
+    }
+    Profiler::start();
+    TinySTL::MappedGraph<int, int> m(snapshot, false);
+    Profiler::stop();
+    cout << "snapshot open       \tedges: " << m.numOfEdges() << "\t" << Profiler::millisecond()
+         << " milliseconds" << endl;
+    Profiler::start();
+    long long mappedSum = touchAll(m);
+    Profiler::stop();
+    cout << "snapshot scan       \tedges: " << m.numOfEdges() << "\t" << Profiler::millisecond()
+         << " milliseconds" << (sum == mappedSum ? "" : "\tMISMATCH") << endl;
+
+    remove(text.c_str());
+    remove(snapshot.c_str());
+    return 0;
+}
@@ -0,0 +1,37 @@
+#include <cstdlib>
+#include <iostream>
+#include "Vector.hpp"
+#include "Profiler.hpp"
+
+using namespace std;
+
+// push n doubles and report time, reallocations, relocated bytes and the
+// capacity left unused at the end (the overhead shrink_to_fit gives back)
+template <typename Policy>
+void run(const char* name, size_t n) {
+    typedef TinySTL::counted_growth<Policy> Counted;
+    Counted::reset();
+    TinySTL::vector<double, TinySTL::allocator<double>, Counted> vec;
+    Profiler::start();
+    for (size_t i = 0; i < n; i++) {
+        vec.push_back((double)i);
+    }
+    Profiler::stop();
+    double slack = double(vec.capacity() - vec.size()) / vec.size() * 100;
+    cout << name << "\t" << Profiler::millisecond() << " milliseconds"
+         << "\treallocations: " << Counted::stats().reallocations.load()
+         << "\tMB moved: " << Counted::stats().bytesMoved.load() / 1e6
+         << "\tunused capacity: " << slack << "%" << endl;
+}
+
+int main(int argc, char* argv[]) {
+    size_t maxSize = argc > 1 ? strtoul(argv[1], NULL, 10) : 100000000;
+    for (size_t n = 1000; n <= maxSize; n *= 10) {
+        cout << "push_back " << n << " doubles" << endl;
+        // odd sizes show the slack each policy leaves
+        run<TinySTL::growth_2x>("growth_2x  ", n + n / 3);
+        run<TinySTL::growth_1_5x>("growth_1_5x", n + n / 3);
+        run<TinySTL::page_growth<>>("page_growth", n + n / 3);
+    }
+    return 0;
+}
@@ -0,0 +1,121 @@
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <queue>
+#include "MinHeap.hpp"
+#include "priority_queue.hpp"
+#include "Profiler.hpp"
+
+using namespace std;
+
+// heap sort through each library heap: insert every key, then drain it
+
+static long long comparisons;
+
+struct CountingLess {
+    bool operator()(int a, int b) const {
+        comparisons++;
+        return a < b;
+    }
+};
+
+struct CountingGreater {
+    bool operator()(int a, int b) const {
+        comparisons++;
+        return a > b;
+    }
+};
+
+template <typename Queue>
+void heapSort(const char* name, int* A, int n) {
+    comparisons = 0;
+    Profiler::start();
+    Queue pq;
+    for (int i = 0; i < n; i++) {
+        pq.push(A[i]);
+    }
+    for (int i = 0; i < n; i++) {
+        A[i] = pq.top();
+        pq.pop();
+    }
+    Profiler::stop();
+    cout << name << "\tsize: " << n << "\t" << Profiler::millisecond() << " milliseconds";
+    if (comparisons != 0) {
+        cout << "\tcomparisons: " << comparisons;
+    }
+    cout << (is_sorted(A, A + n) ? "" : "\tNOT SORTED") << endl;
+}
+
+void minHeapSort(int* A, int n) {
+    Profiler::start();
+    TinySTL::MinHeap<int> heap;
+    for (int i = 0; i < n; i++) {
+        heap.insert(A[i]);
+    }
+    for (int i = 0; i < n; i++) {
+        heap.remove(A[i]);
+    }
+    Profiler::stop();
+    cout << "TinySTL::MinHeap        \tsize: " << n << "\t" << Profiler::millisecond()
+         << " milliseconds" << (is_sorted(A, A + n) ? "" : "\tNOT SORTED") << endl;
+}
+
+// timer-wheel pattern: every tick enqueues a batch and expires as many
+template <bool Batched>
+void ticks(const char* name, const TinySTL::vector<int>& keys, int batch) {
+    TinySTL::priority_queue<int> pq;
+    TinySTL::vector<int> expired(batch);
+    long long sum = 0;
+    Profiler::start();
+    for (size_t i = 0; i + batch <= keys.size(); i += batch) {
+        if (Batched) {
+            pq.push_range(keys.begin() + i, keys.begin() + i + batch);
+        } else {
+            for (int j = 0; j < batch; j++) {
+                pq.push(keys[i + j]);
+            }
+        }
+        pq.pop_n(batch / 2, expired.begin());
+        sum += expired[0];
+    }
+    Profiler::stop();
+    cout << name << "	batch: " << batch << "	" << Profiler::millisecond() << " milliseconds"
+         << (sum == 42 ? "!" : "") << endl;
+}
+
+int main(int argc, char* argv[]) {
+    int maxSize = argc > 1 ? atoi(argv[1]) : 10000000;
+    TinySTL::vector<int> keys, A;
+    for (int sz = 1000; sz <= maxSize; sz *= 10) {
+        keys.resize(sz);
+        for (int i = 0; i < sz; i++) {
+            keys[i] = rand();
+        }
+        // the first two runs count comparisons, libstdc++ sifts bottom-up too
+        A = keys;
+        heapSort<TinySTL::priority_queue<int, TinySTL::vector<int>, CountingLess>>(
+            "TinySTL::priority_queue ", A.begin(), sz);
+        A = keys;
+        // std::priority_queue is a max heap, so it gets the reversed comparator
+        heapSort<std::priority_queue<int, std::vector<int>, CountingGreater>>(
+            "std::priority_queue     ", A.begin(), sz);
+        A = keys;
+        heapSort<TinySTL::priority_queue<int>>("TinySTL::priority_queue ", A.begin(), sz);
+        A = keys;
+        heapSort<TinySTL::aligned_priority_queue<int, 4>>("4-ary priority_queue    ", A.begin(), sz);
+        A = keys;
+        minHeapSort(A.begin(), sz);
+        A = keys;
+        Profiler::start();
+        sort(A.begin(), A.begin() + sz);
+        Profiler::stop();
+        cout << "std::sort               \tsize: " << sz << "\t" << Profiler::millisecond()
+             << " milliseconds" << endl;
+    }
+
+    for (int batch = 16; batch <= 65536; batch *= 16) {
+        ticks<true>("push_range", keys, batch);
+        ticks<false>("push loop ", keys, batch);
+    }
+    return 0;
+}
@@ -0,0 +1,52 @@
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "MmapAllocator.hpp"
+#include "Vector.hpp"
+#include "Profiler.hpp"
+
+using namespace std;
+
+// fill a vector of 8-byte values up to the given number of bytes by
+// push_back, so every growth step goes through reserve()
+template <typename Vec>
+void fill(const char* name, size_t bytes) {
+    size_t n = bytes / sizeof(unsigned long long);
+    Profiler::start();
+    Vec vec;
+    for (size_t i = 0; i < n; i++) {
+        vec.push_back(i);
+    }
+    Profiler::stop();
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    cout << name << "\t" << Profiler::millisecond() << " milliseconds"
+         << "\tpeak RSS: " << usage.ru_maxrss / 1024 << " MB" << endl;
+}
+
+// each variant runs in its own process so peak RSS is not shared
+template <typename Vec>
+void runIsolated(const char* name, size_t bytes) {
+    pid_t pid = fork();
+    if (pid == 0) {
+        fill<Vec>(name, bytes);
+        exit(0);
+    }
+    int status;
+    waitpid(pid, &status, 0);
+}
+
+int main(int argc, char* argv[]) {
+    size_t megabytes = argc > 1 ? strtoul(argv[1], NULL, 10) : 1024;
+    size_t bytes = megabytes << 20;
+    cout << "push_back up to " << megabytes << " MB of unsigned long long" << endl;
+    runIsolated<TinySTL::vector<unsigned long long>>("allocator (copy on growth)", bytes);
+    runIsolated<TinySTL::vector<unsigned long long,
+        TinySTL::mmap_allocator<unsigned long long>>>("mmap_allocator (mremap)  ", bytes);
+    runIsolated<TinySTL::vector<unsigned long long,
+        TinySTL::mmap_allocator<unsigned long long, ((size_t)1 << 21), true>>>("mmap_allocator + THP     ", bytes);
+    return 0;
+}
@@ -0,0 +1,49 @@
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include "priority_queue.hpp"
+#include "Profiler.hpp"
+
+using namespace std;
+
+// push n random keys, then pop them all
+template <typename Queue>
+void run(const char* name, const TinySTL::vector<int>& keys) {
+    Queue pq;
+    long long sum = 0;
+    Profiler::start();
+    for (size_t i = 0; i < keys.size(); i++) {
+        pq.push(keys[i]);
+    }
+    Profiler::stop();
+    double pushed = Profiler::millisecond();
+    Profiler::start();
+    while (!pq.empty()) {
+        sum += pq.top();
+        pq.pop();
+    }
+    Profiler::stop();
+    double popped = Profiler::millisecond();
+    cout << name << "\tpush: " << pushed << " ms\tpop: " << popped << " ms"
+         << (sum == 42 ? "!" : "") << endl;
+}
+
+int main(int argc, char* argv[]) {
+    size_t maxN = argc > 1 ? strtoul(argv[1], NULL, 10) : 100000000;
+    typedef TinySTL::vector<int> Plain;
+    typedef TinySTL::vector<int, TinySTL::aligned_allocator<int, 64>> Aligned;
+    mt19937 gen(1);
+    for (size_t n = 1000000; n <= maxN; n *= 10) {
+        TinySTL::vector<int> keys(n);
+        for (size_t i = 0; i < n; i++) {
+            keys[i] = (int)gen();
+        }
+        cout << "n = " << n << endl;
+        run<TinySTL::priority_queue<int, Plain, less<int>, 2>>("binary          ", keys);
+        run<TinySTL::priority_queue<int, Plain, less<int>, 4>>("4-ary           ", keys);
+        run<TinySTL::priority_queue<int, Aligned, less<int>, 4>>("4-ary, aligned  ", keys);
+        run<TinySTL::priority_queue<int, Aligned, less<int>, 8>>("8-ary, aligned  ", keys);
+        run<TinySTL::priority_queue<int, Aligned, less<int>, 16>>("16-ary, aligned ", keys);
+    }
+    return 0;
+}
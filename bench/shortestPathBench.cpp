@@ -0,0 +1,104 @@
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <utility>
+#include "GraphCSR.hpp"
+#include "ShortestPath.hpp"
+#include "priority_queue.hpp"
+#include "Vector.hpp"
+#include "Profiler.hpp"
+
+using namespace std;
+
+// Road-network-like graph: a width x height grid with two-way streets of
+// random length plus a sprinkling of longer highway links; degree ~4 and a
+// large diameter, like the DIMACS road graphs.
+TinySTL::GraphCSR<int, int> roadGrid(int width, int height, unsigned seed) {
+    mt19937 gen(seed);
+    uniform_int_distribution<int> street(100, 1000);
+    uniform_int_distribution<int> anywhere(0, width * height - 1);
+    TinySTL::vector<TinySTL::WeightedEdge<int> > edges;
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            int v = y * width + x;
+            if (x + 1 < width) {
+                int w = street(gen);
+                edges.push_back(TinySTL::WeightedEdge<int>(v, v + 1, w));
+                edges.push_back(TinySTL::WeightedEdge<int>(v + 1, v, w));
+            }
+            if (y + 1 < height) {
+                int w = street(gen);
+                edges.push_back(TinySTL::WeightedEdge<int>(v, v + width, w));
+                edges.push_back(TinySTL::WeightedEdge<int>(v + width, v, w));
+            }
+        }
+    }
+    for (int i = 0; i < width * height / 100; i++) {
+        int a = anywhere(gen), b = anywhere(gen);
+        int dx = abs(a % width - b % width), dy = abs(a / width - b / width);
+        int w = 300 * (dx + dy);  // faster than streets, never a shortcut to nowhere
+        edges.push_back(TinySTL::WeightedEdge<int>(a, b, w));
+        edges.push_back(TinySTL::WeightedEdge<int>(b, a, w));
+    }
+    TinySTL::vector<int> values(width * height, 0);
+    return TinySTL::GraphCSR<int, int>(values, edges);
+}
+
+// textbook Dijkstra on TinySTL::priority_queue with lazy deletion: a
+// shorter path pushes a duplicate entry instead of decreasing a key
+template <typename Graph>
+TinySTL::vector<int> lazyDijkstra(const Graph& g, int source) {
+    TinySTL::vector<int> dist(g.numOfVertices(), TinySTL::ShortestPaths<int>::unreachable());
+    TinySTL::priority_queue<pair<int, int> > queue;
+    dist[source] = 0;
+    queue.push(make_pair(0, source));
+    while (!queue.empty()) {
+        pair<int, int> top = queue.top();
+        queue.pop();
+        if (top.first > dist[top.second]) {
+            continue;
+        }
+        for (const auto& e : g.neighbours(top.second)) {
+            int nd = top.first + e.weight;
+            if (nd < dist[e.dest]) {
+                dist[e.dest] = nd;
+                queue.push(make_pair(nd, e.dest));
+            }
+        }
+    }
+    return dist;
+}
+
+int main(int argc, char* argv[]) {
+    int side = argc > 1 ? atoi(argv[1]) : 1000;
+    unsigned maxThreads = argc > 2 ? (unsigned)atoi(argv[2]) : TinySTL::defaultThreads();
+
+    TinySTL::GraphCSR<int, int> g = roadGrid(side, side, 5);
+    cout << side << "x" << side << " road grid: " << g.numOfVertices() << " vertices, "
+         << g.numOfEdges() << " edges" << endl;
+    int source = side / 2 * side + side / 2;
+
+    Profiler::start();
+    TinySTL::vector<int> lazy = lazyDijkstra(g, source);
+    Profiler::stop();
+    cout << "Dijkstra, priority_queue + lazy deletion\t" << Profiler::millisecond() << " milliseconds" << endl;
+
+    Profiler::start();
+    TinySTL::ShortestPaths<int> exact = TinySTL::dijkstra(g, source);
+    Profiler::stop();
+    cout << "Dijkstra, indexed_priority_queue        \t" << Profiler::millisecond() << " milliseconds"
+         << (exact.dist == lazy ? "" : "\tMISMATCH") << endl;
+
+    int deltas[] = {500, 2000, 8000};
+    for (int i = 0; i < 3; i++) {
+        for (unsigned threads = 1; threads <= maxThreads; threads *= 2) {
+            Profiler::start();
+            TinySTL::ShortestPaths<int> r = TinySTL::deltaStepping(g, source, deltas[i], threads);
+            Profiler::stop();
+            cout << "delta-stepping, delta " << deltas[i] << ", " << threads << " thread(s)\t"
+                 << Profiler::millisecond() << " milliseconds"
+                 << (r.dist == exact.dist ? "" : "\tMISMATCH") << endl;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,55 @@
+#include <cstdlib>
+#include <iostream>
+#include "SmallVector.hpp"
+#include "Vector.hpp"
+#include "Profiler.hpp"
+
+using namespace std;
+
+static size_t allocations = 0;
+
+// TinySTL::allocator that counts how often it reaches the heap
+template <typename T>
+class counting_allocator : public TinySTL::allocator<T> {
+public:
+    template <typename U> struct rebind {
+        typedef counting_allocator<U> other;
+    };
+
+    counting_allocator() noexcept { }
+    template <typename U>
+    counting_allocator(const counting_allocator<U>&) noexcept { }
+
+    T* allocate(size_t num, const void* hint = 0) {
+        allocations++;
+        return TinySTL::allocator<T>::allocate(num, hint);
+    }
+};
+
+// short-lived per-request vectors holding 1..maxLen elements
+template <typename Vec>
+void run(const char* name, size_t requests, int maxLen) {
+    allocations = 0;
+    long long sum = 0;
+    Profiler::start();
+    for (size_t i = 0; i < requests; i++) {
+        Vec vec;
+        int len = 1 + (int)(i % maxLen);
+        for (int j = 0; j < len; j++) {
+            vec.push_back(j);
+        }
+        sum += vec[len / 2];
+    }
+    Profiler::stop();
+    cout << name << "\tmax length: " << maxLen << "\tallocations: " << allocations
+         << "\t" << Profiler::millisecond() << " milliseconds" << (sum < 0 ? "!" : "") << endl;
+}
+
+int main(int argc, char* argv[]) {
+    size_t requests = argc > 1 ? strtoul(argv[1], NULL, 10) : 10000000;
+    for (int maxLen = 4; maxLen <= 32; maxLen *= 2) {
+        run<TinySTL::vector<int, counting_allocator<int>>>("vector         ", requests, maxLen);
+        run<TinySTL::small_vector<int, 16, counting_allocator<int>>>("small_vector<16>", requests, maxLen);
+    }
+    return 0;
+}
@@ -0,0 +1,80 @@
+#include <cstdlib>
+#include <iostream>
+#include "UFSet.hpp"
+#include "Vector.hpp"
+#include "Profiler.hpp"
+
+using namespace std;
+
+// the UFSet before path halving: union by size, Find walks without
+// shortening anything
+class NaiveUFSet {
+public:
+    explicit NaiveUFSet(size_t n) { parent.assign(n, -1); }
+
+    int Find(int x) const {
+        while (parent[x] >= 0) {
+            x = parent[x];
+        }
+        return x;
+    }
+    bool inSame(int x1, int x2) const { return Find(x1) == Find(x2); }
+    void Union(int x1, int x2) {
+        int root1 = Find(x1);
+        int root2 = Find(x2);
+        if (root1 == root2) {
+            return;
+        }
+        if (parent[root1] < parent[root2]) {
+            parent[root1] += parent[root2];
+            parent[root2] = root1;
+        }
+        else {
+            parent[root2] += parent[root1];
+            parent[root1] = root2;
+        }
+    }
+    void compact() { }
+
+private:
+    TinySTL::vector<int> parent;
+};
+
+// Build binomial trees (the deepest shape union by size/rank allows: depth
+// log2(n)) by uniting the deepest node of each tree with the other tree,
+// then query pairs of deep nodes queries times.
+template <typename Sets>
+void run(const char* name, int n, int queries, bool compact) {
+    Sets sets(n);
+    long long same = 0;
+    Profiler::start();
+    for (int step = 1; step < n; step *= 2) {
+        for (int i = 0; i + step < n; i += 2 * step) {
+            sets.Union(i + step - 1, i + 2 * step - 1);
+        }
+    }
+    if (compact) {
+        sets.compact();
+    }
+    unsigned x = 12345;
+    for (int q = 0; q < queries; q++) {
+        x = x * 1103515245 + 12345;
+        int a = (int)(x % n) | 1;
+        int b = (int)((x >> 8) % n) | 1;
+        same += sets.inSame(a, b);
+    }
+    Profiler::stop();
+    cout << name << (compact ? " + compact" : "          ") << "\t"
+         << Profiler::millisecond() << " milliseconds" << "\tconnected pairs: " << same << endl;
+}
+
+int main(int argc, char* argv[]) {
+    int n = argc > 1 ? atoi(argv[1]) : (1 << 22);
+    int queries = argc > 2 ? atoi(argv[2]) : 20000000;
+    run<NaiveUFSet>("no compression", n, queries, false);
+    run<TinySTL::UFSet>("UFSet         ", n, queries, false);
+    run<TinySTL::UFSet>("UFSet         ", n, queries, true);
+    run<TinySTL::RankedUFSet>("RankedUFSet   ", n, queries, false);
+    run<TinySTL::RankedUFSet>("RankedUFSet   ", n, queries, true);
+    return 0;
+}
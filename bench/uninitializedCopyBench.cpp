@@ -0,0 +1,91 @@
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include "Memory.hpp"
+#include "Profiler.hpp"
+
+using namespace std;
+
+// the element-wise placement new loop Memory.hpp used for every type
+template <typename T>
+T* loopCopy(const T* first, const T* last, T* result) {
+    for (; first != last; ++result, ++first)
+        new (static_cast<void*>(result)) T(*first);
+    return result;
+}
+
+template <typename T>
+T* loopFill(T* first, size_t n, const T& x) {
+    for (; n--; ++first)
+        new (static_cast<void*>(first)) T(x);
+    return first;
+}
+
+template <typename T>
+void benchCopy(const char* name, size_t n, int rounds) {
+    T* src = static_cast<T*>(::operator new(n * sizeof(T)));
+    T* dst = static_cast<T*>(::operator new(n * sizeof(T)));
+    for (size_t i = 0; i < n; i++) {
+        src[i] = T(rand());
+    }
+    double bytes = double(n) * sizeof(T) * rounds;
+
+    Profiler::start();
+    for (int r = 0; r < rounds; r++) {
+        loopCopy(src, src + n, dst);
+    }
+    Profiler::stop();
+    double loopTime = Profiler::second();
+
+    Profiler::start();
+    for (int r = 0; r < rounds; r++) {
+        TinySTL::uninitialized_copy(src, src + n, dst);
+    }
+    Profiler::stop();
+    double fastTime = Profiler::second();
+
+    cout << name << " copy  size: " << n << "\t"
+         << "loop " << bytes / loopTime / 1e9 << " GB/s\t"
+         << "uninitialized_copy " << bytes / fastTime / 1e9 << " GB/s" << endl;
+
+    ::operator delete(src);
+    ::operator delete(dst);
+}
+
+template <typename T>
+void benchFill(const char* name, size_t n, int rounds) {
+    T* dst = static_cast<T*>(::operator new(n * sizeof(T)));
+    double bytes = double(n) * sizeof(T) * rounds;
+
+    Profiler::start();
+    for (int r = 0; r < rounds; r++) {
+        loopFill(dst, n, T(r));
+    }
+    Profiler::stop();
+    double loopTime = Profiler::second();
+
+    Profiler::start();
+    for (int r = 0; r < rounds; r++) {
+        TinySTL::uninitialized_fill_n(dst, n, T(r));
+    }
+    Profiler::stop();
+    double fastTime = Profiler::second();
+
+    cout << name << " fill  size: " << n << "\t"
+         << "loop " << bytes / loopTime / 1e9 << " GB/s\t"
+         << "uninitialized_fill_n " << bytes / fastTime / 1e9 << " GB/s" << endl;
+
+    ::operator delete(dst);
+}
+
+int main(int argc, char* argv[]) {
+    size_t maxSize = argc > 1 ? strtoul(argv[1], NULL, 10) : (size_t)1 << 24;
+    for (size_t n = 1024; n <= maxSize; n *= 16) {
+        int rounds = (int)(((size_t)1 << 28) / (n * sizeof(double))) + 1;
+        benchCopy<int>("int   ", n, rounds);
+        benchCopy<double>("double", n, rounds);
+        benchFill<int>("int   ", n, rounds);
+        benchFill<char>("char  ", n, rounds);
+    }
+    return 0;
+}
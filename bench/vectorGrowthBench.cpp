@@ -0,0 +1,67 @@
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "Vector.hpp"
+#include "Profiler.hpp"
+
+using namespace std;
+
+// A string whose move constructor may throw: move_if_noexcept falls back to
+// copying it, which is exactly what reserve() did for every type before.
+struct CopyRelocatedString {
+    string s;
+    CopyRelocatedString(const string& str) : s(str) {}
+    CopyRelocatedString(const CopyRelocatedString& rhs) : s(rhs.s) {}
+    CopyRelocatedString(CopyRelocatedString&& rhs) noexcept(false) : s(std::move(rhs.s)) {}
+};
+
+template <typename Vec, typename Elem>
+double pushStrings(size_t n, const string& payload) {
+    Profiler::start();
+    {
+        Vec vec;
+        for (size_t i = 0; i < n; i++) {
+            vec.push_back(Elem(payload));
+        }
+    }
+    Profiler::stop();
+    return Profiler::millisecond();
+}
+
+template <typename Vec>
+double pushNested(size_t n) {
+    Profiler::start();
+    {
+        Vec vec;
+        for (size_t i = 0; i < n; i++) {
+            vec.push_back(typename Vec::value_type(4, (int)i));
+        }
+    }
+    Profiler::stop();
+    return Profiler::millisecond();
+}
+
+int main(int argc, char* argv[]) {
+    size_t n = argc > 1 ? strtoul(argv[1], NULL, 10) : 10000000;
+    // longer than the SSO buffer so every copy allocates
+    string payload(40, 'x');
+
+    cout << "push_back " << n << " strings" << endl;
+    cout << "copy relocation (old reserve):\t"
+         << pushStrings<TinySTL::vector<CopyRelocatedString>, CopyRelocatedString>(n, payload)
+         << " milliseconds" << endl;
+    cout << "move relocation:\t\t"
+         << pushStrings<TinySTL::vector<string>, string>(n, payload)
+         << " milliseconds" << endl;
+    cout << "std::vector:\t\t\t"
+         << pushStrings<std::vector<string>, string>(n, payload)
+         << " milliseconds" << endl;
+
+    cout << "push_back " << n << " nested vectors" << endl;
+    cout << "TinySTL::vector<TinySTL::vector<int>> (bitwise relocation):\t"
+         << pushNested<TinySTL::vector<TinySTL::vector<int>>>(n) << " milliseconds" << endl;
+    cout << "std::vector<std::vector<int>>:\t\t\t\t"
+         << pushNested<std::vector<std::vector<int>>>(n) << " milliseconds" << endl;
+    return 0;
+}
@@ -0,0 +1,474 @@
+#ifndef ALLOCATOR_HPP
+#define ALLOCATOR_HPP
+
+// Allocators that can be plugged into the Alloc parameter of TinySTL
+// containers in place of TinySTL::allocator:
+//
+//   pool_allocator          fixed-size blocks carved from large chunks,
+//                           for node based containers
+//   arena_allocator         bump pointer into a monotonic_arena, freed all
+//                           at once when the arena goes away
+//   thread_cache_allocator  per-thread free lists in power-of-two size
+//                           classes in front of ::operator new
+//   aligned_allocator       buffers aligned to Align bytes (a cache line
+//                           by default)
+
+#include <cstddef>
+#include <cstdlib>
+#include <limits>
+#include <new>
+#include <utility>
+#include "Memory.hpp"
+
+namespace TinySTL {
+
+    // type definitions and object construction shared by every allocator
+    template <typename T>
+    class allocator_base {
+    public: // type definitions
+        using value_type        = T;
+        using reference         = value_type&;
+        using const_reference   = const value_type&;
+        using pointer           = value_type*;
+        using const_pointer     = const value_type*;
+        using difference_type   = std::ptrdiff_t;
+        using size_type         = std::size_t;
+
+    public:
+              pointer address(reference x) const noexcept       { return &x; }
+        const_pointer address(const_reference x) const noexcept { return &x; }
+
+        size_type max_size() const noexcept {
+            return std::numeric_limits<std::size_t>::max() / sizeof(value_type);
+        }
+
+        template <typename U, typename... Args>
+        void construct(U* p, Args&&... args) {
+            new (static_cast<void*>(p))U(std::forward<Args>(args)...);
+        }
+
+        template <typename U>
+        void destroy(U* p) {
+            p->~U();
+        }
+    };
+
+    // fixed_pool
+    //
+    // Hands out blocks of a single size. Blocks are carved from chunks of
+    // blocksPerChunk blocks and recycled through an intrusive free list; the
+    // chunks themselves are only returned to the system by release() or the
+    // destructor. With maxBlocksPerChunk above blocksPerChunk every chunk is
+    // twice the size of the previous one up to that limit, so small pools
+    // stay small. Not thread safe.
+    class fixed_pool {
+    public:
+        explicit fixed_pool(std::size_t blockSize, std::size_t blocksPerChunk = 1024,
+                            std::size_t maxBlocksPerChunk = 0)
+            : blockSize(roundUp(blockSize < sizeof(FreeBlock) ? sizeof(FreeBlock) : blockSize)),
+              firstChunkBlocks(blocksPerChunk == 0 ? 1 : blocksPerChunk),
+              maxChunkBlocks(maxBlocksPerChunk < firstChunkBlocks ? firstChunkBlocks : maxBlocksPerChunk),
+              blocksPerChunk(firstChunkBlocks),
+              freeList(nullptr),
+              chunks(nullptr) {
+        }
+
+        fixed_pool(const fixed_pool&) = delete;
+        fixed_pool& operator=(const fixed_pool&) = delete;
+
+        ~fixed_pool() { release(); }
+
+        void* allocate() {
+            if (freeList == nullptr) {
+                refill(blocksPerChunk);
+                if (blocksPerChunk < maxChunkBlocks) {
+                    blocksPerChunk = 2 * blocksPerChunk < maxChunkBlocks ? 2 * blocksPerChunk : maxChunkBlocks;
+                }
+            }
+            FreeBlock* p = freeList;
+            freeList = p->next;
+            return p;
+        }
+
+        void deallocate(void* p) {
+            FreeBlock* block = static_cast<FreeBlock*>(p);
+            block->next = freeList;
+            freeList = block;
+        }
+
+        // carve a chunk of n blocks now, e.g. before copying n known nodes
+        void add_chunk(std::size_t n) {
+            if (n > 0) {
+                refill(n);
+            }
+        }
+
+        // return every chunk at once, invalidating all outstanding blocks;
+        // chunk growth starts over
+        void release() {
+            while (chunks != nullptr) {
+                Chunk* next = chunks->next;
+                ::operator delete(static_cast<void*>(chunks));
+                chunks = next;
+            }
+            freeList = nullptr;
+            blocksPerChunk = firstChunkBlocks;
+        }
+
+        std::size_t block_size() const { return blockSize; }
+
+    private:
+        struct FreeBlock { FreeBlock* next; };
+        struct Chunk { Chunk* next; };
+
+        static std::size_t roundUp(std::size_t n) {
+            const std::size_t align = alignof(std::max_align_t);
+            return (n + align - 1) / align * align;
+        }
+
+        void refill(std::size_t n) {
+            std::size_t header = roundUp(sizeof(Chunk));
+            char* raw = static_cast<char*>(::operator new(header + blockSize * n));
+            Chunk* chunk = reinterpret_cast<Chunk*>(raw);
+            chunk->next = chunks;
+            chunks = chunk;
+            // thread the new blocks onto the free list in address order
+            char* first = raw + header;
+            for (std::size_t i = n; i > 0; i--) {
+                deallocate(first + (i - 1) * blockSize);
+            }
+        }
+
+    private:
+        std::size_t blockSize;
+        std::size_t firstChunkBlocks;
+        std::size_t maxChunkBlocks;
+        std::size_t blocksPerChunk;  // size of the next chunk
+        FreeBlock* freeList;
+        Chunk* chunks;
+    };
+
+    // pool_allocator
+    //
+    // Single object requests (the node allocations of lists, trees and
+    // graphs) come from a fixed_pool shared by every pool_allocator of the
+    // same value size; array requests fall back to ::operator new. The
+    // shared pool is not thread safe.
+    template <typename T, std::size_t BlocksPerChunk = 1024>
+    class pool_allocator : public allocator_base<T> {
+    public:
+        using typename allocator_base<T>::pointer;
+        using typename allocator_base<T>::size_type;
+
+        template <typename U> struct rebind {
+            typedef pool_allocator<U, BlocksPerChunk> other;
+        };
+
+    public:
+        pool_allocator() noexcept { }
+        template <typename U>
+        pool_allocator(const pool_allocator<U, BlocksPerChunk>&) noexcept { }
+
+        pointer allocate(size_type num, const void* = 0) {
+            if (num == 1) {
+                return static_cast<pointer>(pool().allocate());
+            }
+            return static_cast<pointer>(::operator new(num * sizeof(T)));
+        }
+
+        void deallocate(pointer p, size_type num) {
+            if (num == 1) {
+                pool().deallocate(p);
+            } else {
+                ::operator delete(static_cast<void*>(p));
+            }
+        }
+
+        static fixed_pool& pool() {
+            static fixed_pool sharedPool(sizeof(T), BlocksPerChunk);
+            return sharedPool;
+        }
+    };
+
+    template <typename T, typename U, std::size_t N>
+    bool operator==(const pool_allocator<T, N>&, const pool_allocator<U, N>&) { return true; }
+    template <typename T, typename U, std::size_t N>
+    bool operator!=(const pool_allocator<T, N>&, const pool_allocator<U, N>&) { return false; }
+
+    // monotonic_arena
+    //
+    // Bump pointer allocation out of a list of chunks. Individual frees are
+    // ignored, except that freeing the most recent allocation rolls the bump
+    // pointer back, so short-lived scratch buffers don't use up the chunk.
+    // All memory is returned by release() or the destructor. Not thread safe.
+    class monotonic_arena {
+    public:
+        explicit monotonic_arena(std::size_t chunkSize = 64 * 1024)
+            : chunkSize(chunkSize), chunks(nullptr), cur(nullptr), end(nullptr),
+              last(nullptr), used(0) {
+        }
+
+        monotonic_arena(const monotonic_arena&) = delete;
+        monotonic_arena& operator=(const monotonic_arena&) = delete;
+
+        ~monotonic_arena() { release(); }
+
+        void* allocate(std::size_t bytes, std::size_t align = alignof(std::max_align_t)) {
+            char* p = cur == nullptr ? nullptr : alignUp(cur, align);
+            if (p == nullptr || p > end || (std::size_t)(end - p) < bytes) {
+                newChunk(bytes + align);
+                p = alignUp(cur, align);
+            }
+            cur = p + bytes;
+            last = p;
+            used += bytes;
+            return p;
+        }
+
+        void deallocate(void* p, std::size_t bytes) {
+            if (p != nullptr && p == last && static_cast<char*>(p) + bytes == cur) {
+                cur = last;
+                last = nullptr;
+                used -= bytes;
+            }
+        }
+
+        void release() {
+            while (chunks != nullptr) {
+                Chunk* next = chunks->next;
+                ::operator delete(static_cast<void*>(chunks));
+                chunks = next;
+            }
+            cur = end = last = nullptr;
+            used = 0;
+        }
+
+        // bytes handed out and not rolled back since the last release()
+        std::size_t bytes_allocated() const { return used; }
+
+    private:
+        struct Chunk { Chunk* next; };
+
+        static char* alignUp(char* p, std::size_t align) {
+            std::size_t addr = reinterpret_cast<std::size_t>(p);
+            return reinterpret_cast<char*>((addr + align - 1) / align * align);
+        }
+
+        void newChunk(std::size_t minBytes) {
+            std::size_t size = sizeof(Chunk) + (minBytes > chunkSize ? minBytes : chunkSize);
+            char* raw = static_cast<char*>(::operator new(size));
+            Chunk* chunk = reinterpret_cast<Chunk*>(raw);
+            chunk->next = chunks;
+            chunks = chunk;
+            cur = raw + sizeof(Chunk);
+            end = raw + size;
+            last = nullptr;
+        }
+
+    private:
+        std::size_t chunkSize;
+        Chunk* chunks;
+        char* cur;
+        char* end;
+        char* last;
+        std::size_t used;
+    };
+
+    // arena_allocator: allocator interface over a caller owned arena
+    template <typename T>
+    class arena_allocator : public allocator_base<T> {
+    public:
+        using typename allocator_base<T>::pointer;
+        using typename allocator_base<T>::size_type;
+
+        template <typename U> struct rebind {
+            typedef arena_allocator<U> other;
+        };
+
+        template <typename U> friend class arena_allocator;
+
+    public:
+        explicit arena_allocator(monotonic_arena& arena) noexcept : arena(&arena) { }
+        template <typename U>
+        arena_allocator(const arena_allocator<U>& rhs) noexcept : arena(rhs.arena) { }
+
+        pointer allocate(size_type num, const void* = 0) {
+            return static_cast<pointer>(arena->allocate(num * sizeof(T), alignof(T)));
+        }
+
+        void deallocate(pointer p, size_type num) {
+            arena->deallocate(p, num * sizeof(T));
+        }
+
+        monotonic_arena* resource() const noexcept { return arena; }
+
+    private:
+        monotonic_arena* arena;
+    };
+
+    template <typename T, typename U>
+    bool operator==(const arena_allocator<T>& lhs, const arena_allocator<U>& rhs) {
+        return lhs.resource() == rhs.resource();
+    }
+    template <typename T, typename U>
+    bool operator!=(const arena_allocator<T>& lhs, const arena_allocator<U>& rhs) {
+        return !(lhs == rhs);
+    }
+
+    // thread_cache
+    //
+    // Per-thread free lists for power-of-two size classes between MinBlock
+    // and MaxBlock bytes. A freed block goes onto the free list of the
+    // thread that frees it, so producer/consumer hand-offs work; every block
+    // ultimately comes from and returns to ::operator new/delete.
+    class thread_cache {
+    public:
+        static const std::size_t MinShift   = 4;   // 16 bytes
+        static const std::size_t MaxShift   = 15;  // 32 KiB
+        static const std::size_t NumClasses = MaxShift - MinShift + 1;
+        static const std::size_t MaxCached  = 256; // blocks kept per class
+
+        static thread_cache& local() {
+            static thread_local thread_cache cache;
+            return cache;
+        }
+
+        thread_cache() {
+            for (std::size_t i = 0; i < NumClasses; i++) {
+                lists[i] = nullptr;
+                counts[i] = 0;
+            }
+        }
+
+        thread_cache(const thread_cache&) = delete;
+        thread_cache& operator=(const thread_cache&) = delete;
+
+        ~thread_cache() {
+            for (std::size_t i = 0; i < NumClasses; i++) {
+                while (lists[i] != nullptr) {
+                    FreeBlock* next = lists[i]->next;
+                    ::operator delete(static_cast<void*>(lists[i]));
+                    lists[i] = next;
+                }
+            }
+        }
+
+        void* allocate(std::size_t bytes) {
+            if (bytes > ((std::size_t)1 << MaxShift)) {
+                return ::operator new(bytes);
+            }
+            std::size_t c = sizeClass(bytes);
+            FreeBlock* p = lists[c];
+            if (p == nullptr) {
+                return ::operator new((std::size_t)1 << (c + MinShift));
+            }
+            lists[c] = p->next;
+            counts[c]--;
+            return p;
+        }
+
+        void deallocate(void* p, std::size_t bytes) {
+            if (bytes > ((std::size_t)1 << MaxShift)) {
+                ::operator delete(p);
+                return;
+            }
+            std::size_t c = sizeClass(bytes);
+            if (counts[c] >= MaxCached) {
+                ::operator delete(p);
+                return;
+            }
+            FreeBlock* block = static_cast<FreeBlock*>(p);
+            block->next = lists[c];
+            lists[c] = block;
+            counts[c]++;
+        }
+
+    private:
+        struct FreeBlock { FreeBlock* next; };
+
+        static std::size_t sizeClass(std::size_t bytes) {
+            std::size_t c = 0;
+            while (((std::size_t)1 << (c + MinShift)) < bytes) {
+                c++;
+            }
+            return c;
+        }
+
+    private:
+        FreeBlock* lists[NumClasses];
+        std::size_t counts[NumClasses];
+    };
+
+    template <typename T>
+    class thread_cache_allocator : public allocator_base<T> {
+    public:
+        using typename allocator_base<T>::pointer;
+        using typename allocator_base<T>::size_type;
+
+        template <typename U> struct rebind {
+            typedef thread_cache_allocator<U> other;
+        };
+
+    public:
+        thread_cache_allocator() noexcept { }
+        template <typename U>
+        thread_cache_allocator(const thread_cache_allocator<U>&) noexcept { }
+
+        pointer allocate(size_type num, const void* = 0) {
+            return static_cast<pointer>(thread_cache::local().allocate(num * sizeof(T)));
+        }
+
+        void deallocate(pointer p, size_type num) {
+            thread_cache::local().deallocate(p, num * sizeof(T));
+        }
+    };
+
+    template <typename T, typename U>
+    bool operator==(const thread_cache_allocator<T>&, const thread_cache_allocator<U>&) { return true; }
+    template <typename T, typename U>
+    bool operator!=(const thread_cache_allocator<T>&, const thread_cache_allocator<U>&) { return false; }
+
+    // aligned_allocator
+    //
+    // Every buffer starts on an Align byte boundary (a power of two), so a
+    // container can lay out its elements in cache-line sized groups. Built
+    // on ::operator new: the block is over-allocated and the original
+    // pointer is stashed just below the aligned address.
+    template <typename T, std::size_t Align = 64>
+    class aligned_allocator : public allocator_base<T> {
+        static_assert((Align & (Align - 1)) == 0, "Align must be a power of two");
+
+    public:
+        using typename allocator_base<T>::pointer;
+        using typename allocator_base<T>::size_type;
+
+        template <typename U> struct rebind {
+            typedef aligned_allocator<U, Align> other;
+        };
+
+    public:
+        aligned_allocator() noexcept { }
+        template <typename U>
+        aligned_allocator(const aligned_allocator<U, Align>&) noexcept { }
+
+        pointer allocate(size_type num, const void* = 0) {
+            char* raw = static_cast<char*>(::operator new(num * sizeof(T) + Align - 1 + sizeof(void*)));
+            std::size_t addr = reinterpret_cast<std::size_t>(raw + sizeof(void*));
+            char* aligned = reinterpret_cast<char*>((addr + Align - 1) & ~(Align - 1));
+            reinterpret_cast<void**>(aligned)[-1] = raw;
+            return reinterpret_cast<pointer>(aligned);
+        }
+
+        void deallocate(pointer p, size_type) {
+            ::operator delete(reinterpret_cast<void**>(p)[-1]);
+        }
+    };
+
+    template <typename T, typename U, std::size_t A>
+    bool operator==(const aligned_allocator<T, A>&, const aligned_allocator<U, A>&) { return true; }
+    template <typename T, typename U, std::size_t A>
+    bool operator!=(const aligned_allocator<T, A>&, const aligned_allocator<U, A>&) { return false; }
+
+}  // namespace TinySTL
+
+#endif  // ALLOCATOR_HPP
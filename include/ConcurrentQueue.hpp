@@ -0,0 +1,387 @@
+#ifndef CONCURRENT_QUEUE_HPP
+#define CONCURRENT_QUEUE_HPP
+
+// Bounded lock-free queues for passing items between threads
+//
+// Both queues keep their slots in a TinySTL::vector whose size is rounded
+// up to a power of two, so a position maps to a slot with a mask. Positions
+// are 64-bit counters that only grow and never wrap in practice.
+//
+// spsc_queue: one producer thread and one consumer thread. The producer
+// owns tail and the consumer owns head; each lives on its own cache line
+// next to a cached copy of the other side's index, so the shared line is
+// only read when the cached value says the queue looks full (or empty).
+//
+// mpmc_queue: any number of producers and consumers (Vyukov's bounded
+// queue). Every slot carries a sequence number telling which round of
+// the ring may use it next; a thread claims a position with one CAS and
+// publishes the slot by bumping its sequence.
+//
+// The batch operations claim a run of slots at once and publish them with
+// a single store (spsc) or a single CAS (mpmc).
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "Vector.hpp"
+
+namespace TinySTL {
+
+    // assumed size of a cache line, used to keep hot indices apart
+    static const std::size_t CacheLineSize = 64;
+
+    namespace detail {
+
+        inline std::size_t roundUpToPowerOf2(std::size_t n) {
+            std::size_t capacity = 1;
+            while (capacity < n) {
+                capacity <<= 1;
+            }
+            return capacity;
+        }
+
+    }  // namespace detail
+
+    template <typename T>
+    class spsc_queue {
+       public:
+        using value_type = T;
+        using size_type  = std::size_t;
+
+       public:
+        // capacity is rounded up to a power of two (at least 2)
+        explicit spsc_queue(size_type capacity);
+        spsc_queue(const spsc_queue&) = delete;
+        spsc_queue& operator=(const spsc_queue&) = delete;
+        ~spsc_queue();
+
+        // producer side
+        bool try_push(const value_type& val) { return try_emplace(val); }
+        bool try_push(value_type&& val)      { return try_emplace(std::move(val)); }
+        template <typename... Args>
+        bool try_emplace(Args&&... args);
+        // push a prefix of [first, last); returns how many were pushed
+        template <typename InputIterator>
+        size_type push_batch(InputIterator first, InputIterator last);
+
+        // consumer side
+        bool try_pop(value_type& val);
+        // pop up to maxCount items into out; returns how many were popped
+        template <typename OutputIterator>
+        size_type pop_batch(OutputIterator out, size_type maxCount);
+
+        // exact only when called from the producer or consumer thread
+        size_type size_approx() const noexcept {
+            return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+        }
+        bool empty() const noexcept { return size_approx() == 0; }
+        size_type capacity() const noexcept { return mask + 1; }
+
+       private:
+        using storage_type = typename std::aligned_storage<sizeof(T), alignof(T)>::type;
+
+        T* slot(size_type pos) { return reinterpret_cast<T*>(&buffer[pos & mask]); }
+        // slots available to the producer (consumer); the other side's index
+        // is only re-read when the cached one gives fewer than wanted
+        size_type freeSlots(size_type t, size_type wanted);
+        size_type readySlots(size_type h, size_type wanted);
+
+       private:
+        TinySTL::vector<storage_type> buffer;
+        size_type mask;
+
+        // consumer's line
+        alignas(CacheLineSize) std::atomic<size_type> head;
+        size_type cachedTail;
+        // producer's line
+        alignas(CacheLineSize) std::atomic<size_type> tail;
+        size_type cachedHead;
+        char padding[CacheLineSize - sizeof(std::atomic<size_type>) - sizeof(size_type)];
+    };
+
+    template <typename T>
+    class mpmc_queue {
+       public:
+        using value_type = T;
+        using size_type  = std::size_t;
+
+       public:
+        // capacity is rounded up to a power of two (at least 2)
+        explicit mpmc_queue(size_type capacity);
+        mpmc_queue(const mpmc_queue&) = delete;
+        mpmc_queue& operator=(const mpmc_queue&) = delete;
+        ~mpmc_queue();
+
+        bool try_push(const value_type& val) { return try_emplace(val); }
+        bool try_push(value_type&& val)      { return try_emplace(std::move(val)); }
+        template <typename... Args>
+        bool try_emplace(Args&&... args);
+        // push a prefix of [first, last); returns how many were pushed
+        template <typename RandomAccessIterator>
+        size_type push_batch(RandomAccessIterator first, RandomAccessIterator last);
+
+        bool try_pop(value_type& val);
+        // pop up to maxCount items into out; returns how many were popped
+        template <typename OutputIterator>
+        size_type pop_batch(OutputIterator out, size_type maxCount);
+
+        // a snapshot that may be stale as soon as it is returned
+        size_type size_approx() const noexcept {
+            size_type t = enqueuePos.load(std::memory_order_acquire);
+            size_type h = dequeuePos.load(std::memory_order_acquire);
+            return t > h ? t - h : 0;
+        }
+        bool empty() const noexcept { return size_approx() == 0; }
+        size_type capacity() const noexcept { return mask + 1; }
+
+       private:
+        using storage_type = typename std::aligned_storage<sizeof(T), alignof(T)>::type;
+
+        struct Cell {
+            std::atomic<size_type> sequence;
+            storage_type data;
+
+            Cell() : sequence(0) {}
+            // vector copy-constructs its elements; only used before sharing
+            Cell(const Cell& x) : sequence(x.sequence.load(std::memory_order_relaxed)) {}
+
+            T* get() { return reinterpret_cast<T*>(&data); }
+        };
+
+        // claim up to maxCount consecutive slots whose sequence equals
+        // position + offset; returns the first position and sets count
+        size_type claim(std::atomic<size_type>& position, size_type offset,
+                        size_type maxCount, size_type& count);
+
+       private:
+        TinySTL::vector<Cell> buffer;
+        size_type mask;
+
+        alignas(CacheLineSize) std::atomic<size_type> enqueuePos;
+        alignas(CacheLineSize) std::atomic<size_type> dequeuePos;
+        char padding[CacheLineSize - sizeof(std::atomic<size_type>)];
+    };
+
+}  // namespace TinySTL
+
+
+namespace TinySTL {
+
+    //------------------------------------------------------------------
+    // spsc_queue
+
+    template <typename T>
+    spsc_queue<T>::spsc_queue(size_type capacity)
+        : buffer(detail::roundUpToPowerOf2(capacity < 2 ? 2 : capacity)),
+          mask(buffer.size() - 1), head(0), cachedTail(0), tail(0), cachedHead(0) {}
+
+    template <typename T>
+    spsc_queue<T>::~spsc_queue() {
+        size_type t = tail.load(std::memory_order_relaxed);
+        for (size_type h = head.load(std::memory_order_relaxed); h != t; ++h) {
+            slot(h)->~T();
+        }
+    }
+
+    template <typename T>
+    typename spsc_queue<T>::size_type spsc_queue<T>::freeSlots(size_type t, size_type wanted) {
+        size_type n = capacity() - (t - cachedHead);
+        if (n < wanted) {
+            cachedHead = head.load(std::memory_order_acquire);
+            n = capacity() - (t - cachedHead);
+        }
+        return n;
+    }
+
+    template <typename T>
+    typename spsc_queue<T>::size_type spsc_queue<T>::readySlots(size_type h, size_type wanted) {
+        size_type n = cachedTail - h;
+        if (n < wanted) {
+            cachedTail = tail.load(std::memory_order_acquire);
+            n = cachedTail - h;
+        }
+        return n;
+    }
+
+    template <typename T>
+    template <typename... Args>
+    bool spsc_queue<T>::try_emplace(Args&&... args) {
+        size_type t = tail.load(std::memory_order_relaxed);
+        if (freeSlots(t, 1) == 0) {
+            return false;
+        }
+        ::new (static_cast<void*>(slot(t))) T(std::forward<Args>(args)...);
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    template <typename T>
+    template <typename InputIterator>
+    typename spsc_queue<T>::size_type
+    spsc_queue<T>::push_batch(InputIterator first, InputIterator last) {
+        size_type t = tail.load(std::memory_order_relaxed);
+        size_type n = freeSlots(t, capacity());
+        size_type pushed = 0;
+        for (; pushed != n && first != last; ++pushed, ++first) {
+            ::new (static_cast<void*>(slot(t + pushed))) T(*first);
+        }
+        if (pushed != 0) {
+            tail.store(t + pushed, std::memory_order_release);
+        }
+        return pushed;
+    }
+
+    template <typename T>
+    bool spsc_queue<T>::try_pop(value_type& val) {
+        size_type h = head.load(std::memory_order_relaxed);
+        if (readySlots(h, 1) == 0) {
+            return false;
+        }
+        T* p = slot(h);
+        val = std::move(*p);
+        p->~T();
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    template <typename T>
+    template <typename OutputIterator>
+    typename spsc_queue<T>::size_type
+    spsc_queue<T>::pop_batch(OutputIterator out, size_type maxCount) {
+        size_type h = head.load(std::memory_order_relaxed);
+        size_type n = readySlots(h, maxCount);
+        if (n > maxCount) {
+            n = maxCount;
+        }
+        for (size_type i = 0; i != n; ++i, ++out) {
+            T* p = slot(h + i);
+            *out = std::move(*p);
+            p->~T();
+        }
+        if (n != 0) {
+            head.store(h + n, std::memory_order_release);
+        }
+        return n;
+    }
+
+    //------------------------------------------------------------------
+    // mpmc_queue
+
+    template <typename T>
+    mpmc_queue<T>::mpmc_queue(size_type capacity)
+        : buffer(detail::roundUpToPowerOf2(capacity < 2 ? 2 : capacity)),
+          mask(buffer.size() - 1), enqueuePos(0), dequeuePos(0) {
+        // slot i is free for the producer of position i
+        for (size_type i = 0; i <= mask; ++i) {
+            buffer[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    template <typename T>
+    mpmc_queue<T>::~mpmc_queue() {
+        size_type t = enqueuePos.load(std::memory_order_relaxed);
+        for (size_type h = dequeuePos.load(std::memory_order_relaxed); h != t; ++h) {
+            buffer[h & mask].get()->~T();
+        }
+    }
+
+    template <typename T>
+    typename mpmc_queue<T>::size_type
+    mpmc_queue<T>::claim(std::atomic<size_type>& position, size_type offset,
+                         size_type maxCount, size_type& count) {
+        size_type pos = position.load(std::memory_order_relaxed);
+        for (;;) {
+            // count the run of slots ready for this round
+            count = 0;
+            std::ptrdiff_t dif = 0;
+            while (count != maxCount) {
+                size_type seq = buffer[(pos + count) & mask].sequence.load(std::memory_order_acquire);
+                dif = (std::ptrdiff_t)seq - (std::ptrdiff_t)(pos + count + offset);
+                if (dif != 0) {
+                    break;
+                }
+                ++count;
+            }
+            if (count != 0) {
+                if (position.compare_exchange_weak(pos, pos + count, std::memory_order_relaxed)) {
+                    return pos;
+                }
+            } else if (dif < 0) {
+                // the slot still belongs to the previous round: full (or empty)
+                return pos;
+            } else {
+                pos = position.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    template <typename T>
+    template <typename... Args>
+    bool mpmc_queue<T>::try_emplace(Args&&... args) {
+        size_type count;
+        size_type pos = claim(enqueuePos, 0, 1, count);
+        if (count == 0) {
+            return false;
+        }
+        Cell& cell = buffer[pos & mask];
+        ::new (static_cast<void*>(cell.get())) T(std::forward<Args>(args)...);
+        cell.sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    template <typename T>
+    template <typename RandomAccessIterator>
+    typename mpmc_queue<T>::size_type
+    mpmc_queue<T>::push_batch(RandomAccessIterator first, RandomAccessIterator last) {
+        size_type maxCount = last - first;
+        if (maxCount == 0) {
+            return 0;
+        }
+        size_type count;
+        size_type pos = claim(enqueuePos, 0, maxCount, count);
+        for (size_type i = 0; i != count; ++i, ++first) {
+            Cell& cell = buffer[(pos + i) & mask];
+            ::new (static_cast<void*>(cell.get())) T(*first);
+            cell.sequence.store(pos + i + 1, std::memory_order_release);
+        }
+        return count;
+    }
+
+    template <typename T>
+    bool mpmc_queue<T>::try_pop(value_type& val) {
+        size_type count;
+        size_type pos = claim(dequeuePos, 1, 1, count);
+        if (count == 0) {
+            return false;
+        }
+        Cell& cell = buffer[pos & mask];
+        val = std::move(*cell.get());
+        cell.get()->~T();
+        // free the slot for the producer one round later
+        cell.sequence.store(pos + mask + 1, std::memory_order_release);
+        return true;
+    }
+
+    template <typename T>
+    template <typename OutputIterator>
+    typename mpmc_queue<T>::size_type
+    mpmc_queue<T>::pop_batch(OutputIterator out, size_type maxCount) {
+        if (maxCount == 0) {
+            return 0;
+        }
+        size_type count;
+        size_type pos = claim(dequeuePos, 1, maxCount, count);
+        for (size_type i = 0; i != count; ++i, ++out) {
+            Cell& cell = buffer[(pos + i) & mask];
+            *out = std::move(*cell.get());
+            cell.get()->~T();
+            cell.sequence.store(pos + i + mask + 1, std::memory_order_release);
+        }
+        return count;
+    }
+
+}  // namespace TinySTL
+
+#endif  // CONCURRENT_QUEUE_HPP
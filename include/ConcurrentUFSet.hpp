@@ -0,0 +1,166 @@
+#ifndef CONCURRENT_UFSET_HPP
+#define CONCURRENT_UFSET_HPP
+
+// Union-find that many threads may use at once
+//
+// Each element is one 64-bit atomic word holding (rank << 32 | parent); a
+// root is its own parent. Union links the root with the smaller
+// (rank, index) under the other with a single CAS, so there are no locks
+// and no cycles. Find uses path splitting: every node on the walk is
+// pointed at its grandparent with a CAS whose failure is harmless, since
+// another thread has already changed that node to something at least as
+// good.
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <utility>
+#include "Vector.hpp"
+
+namespace TinySTL {
+
+    class ConcurrentUFSet {
+    public:
+        using size_type = std::size_t;
+
+    public:
+        explicit ConcurrentUFSet(size_type n) : nodes(n) {
+            for (size_type i = 0; i < n; ++i) {
+                nodes[i].word.store(pack(0, (int)i), std::memory_order_relaxed);
+            }
+        }
+
+        int Find(int x) {
+            for (;;) {
+                std::uint64_t w = nodes[x].word.load(std::memory_order_acquire);
+                int p = parentOf(w);
+                if (p == x) {
+                    return x;
+                }
+                int gp = parentOf(nodes[p].word.load(std::memory_order_acquire));
+                if (gp != p) {
+                    nodes[x].word.compare_exchange_weak(w, pack(rankOf(w), gp),
+                                                        std::memory_order_release,
+                                                        std::memory_order_relaxed);
+                }
+                x = p;
+            }
+        }
+
+        bool inSame(int x1, int x2) {
+            for (;;) {
+                int root1 = Find(x1);
+                int root2 = Find(x2);
+                if (root1 == root2) {
+                    return true;
+                }
+                // root1 may have been linked after we found it; only a
+                // still-standing root proves the sets were disjoint
+                if (isRoot(root1)) {
+                    return false;
+                }
+            }
+        }
+
+        // returns true if x1 and x2 were in different sets
+        bool Union(int x1, int x2) {
+            for (;;) {
+                int root1 = Find(x1);
+                int root2 = Find(x2);
+                if (root1 == root2) {
+                    return false;
+                }
+                std::uint64_t w1 = nodes[root1].word.load(std::memory_order_acquire);
+                std::uint64_t w2 = nodes[root2].word.load(std::memory_order_acquire);
+                if (parentOf(w1) != root1 || parentOf(w2) != root2) {
+                    continue;
+                }
+                std::uint32_t rank1 = rankOf(w1), rank2 = rankOf(w2);
+                // link the smaller (rank, index) under the larger
+                if (rank1 > rank2 || (rank1 == rank2 && root1 > root2)) {
+                    std::swap(root1, root2);
+                    std::swap(w1, w2);
+                    std::swap(rank1, rank2);
+                }
+                if (!nodes[root1].word.compare_exchange_strong(w1, pack(rank1, root2),
+                                                               std::memory_order_acq_rel)) {
+                    continue;
+                }
+                if (rank1 == rank2) {
+                    // rank is only a balancing hint, losing this race is fine
+                    nodes[root2].word.compare_exchange_strong(w2, pack(rank2 + 1, root2),
+                                                              std::memory_order_acq_rel);
+                }
+                return true;
+            }
+        }
+
+        // Union every (first, second) pair of [first, last) using threads
+        // threads (0: one per core)
+        template <typename RandomAccessIterator>
+        void unionAll(RandomAccessIterator first, RandomAccessIterator last, unsigned threads = 0);
+
+        size_type size() const { return nodes.size(); }
+
+    private:
+        struct Node {
+            std::atomic<std::uint64_t> word;
+
+            Node() : word(0) {}
+            // vector copy-constructs its elements; only used before sharing
+            Node(const Node& x) : word(x.word.load(std::memory_order_relaxed)) {}
+        };
+
+        static std::uint64_t pack(std::uint32_t rank, int parent) {
+            return ((std::uint64_t)rank << 32) | (std::uint32_t)parent;
+        }
+        static int parentOf(std::uint64_t w) { return (int)(std::uint32_t)w; }
+        static std::uint32_t rankOf(std::uint64_t w) { return (std::uint32_t)(w >> 32); }
+
+        bool isRoot(int x) const {
+            return parentOf(nodes[x].word.load(std::memory_order_acquire)) == x;
+        }
+
+    private:
+        TinySTL::vector<Node> nodes;
+    };
+
+} // namespace TinySTL
+
+
+namespace TinySTL {
+
+    template <typename RandomAccessIterator>
+    void ConcurrentUFSet::unionAll(RandomAccessIterator first, RandomAccessIterator last,
+                                   unsigned threads) {
+        if (threads == 0) {
+            threads = std::thread::hardware_concurrency();
+        }
+        size_type count = last - first;
+        if (threads <= 1 || count < 2 * (size_type)threads) {
+            for (; first != last; ++first) {
+                Union((*first).first, (*first).second);
+            }
+            return;
+        }
+        TinySTL::vector<std::thread*> workers;
+        size_type chunk = (count + threads - 1) / threads;
+        for (size_type begin = 0; begin < count; begin += chunk) {
+            size_type end = begin + chunk < count ? begin + chunk : count;
+            workers.push_back(new std::thread([this, first, begin, end] {
+                for (RandomAccessIterator it = first + begin; it != first + end; ++it) {
+                    Union((*it).first, (*it).second);
+                }
+            }));
+        }
+        for (size_type i = 0; i < workers.size(); ++i) {
+            workers[i]->join();
+            delete workers[i];
+        }
+    }
+
+} // namespace TinySTL
+
+
+#endif // CONCURRENT_UFSET_HPP
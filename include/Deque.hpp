@@ -1,10 +1,640 @@
 #ifndef DEQUE_HPP
 #define DEQUE_HPP
 
+// Double-ended queue stored as a map of fixed-size blocks
+//
+// Elements live in blocks of blockSize() elements (about 4 KiB each); a
+// central map holds pointers to the blocks in order. Pushing or popping at
+// either end only touches the end blocks, and growing the map moves block
+// pointers, never elements, so references to elements stay valid across
+// push_front/push_back (iterators are invalidated by map growth).
+
+#include <initializer_list>
+#include <stdexcept>
+#include <cassert>
+#include <utility>
+#include "Iterator.hpp"
+#include "Memory.hpp"
+
+namespace TinySTL {
+
+    template <typename T, typename Ref, typename Ptr>
+    struct deque_iterator
+        : public TinySTL::Iterator::iterator<TinySTL::Iterator::random_access_iterator_tag,
+                                             T, std::ptrdiff_t, Ptr, Ref> {
+        using iterator        = deque_iterator<T, T&, T*>;
+        using const_iterator  = deque_iterator<T, const T&, const T*>;
+        using self            = deque_iterator<T, Ref, Ptr>;
+        using difference_type = std::ptrdiff_t;
+        using map_pointer     = T**;
+
+        static std::size_t blockSize() {
+            return sizeof(T) < 4096 ? 4096 / sizeof(T) : 1;
+        }
+
+        T* cur;    // current element
+        T* first;  // begin of the current block
+        T* last;   // end of the current block
+        map_pointer node;
+
+        deque_iterator() : cur(nullptr), first(nullptr), last(nullptr), node(nullptr) {}
+        deque_iterator(T* x, map_pointer y)
+            : cur(x), first(*y), last(*y + blockSize()), node(y) {}
+        deque_iterator(const iterator& x)
+            : cur(x.cur), first(x.first), last(x.last), node(x.node) {}
+        self& operator=(const self&) = default;
+
+        void setNode(map_pointer newNode) {
+            node  = newNode;
+            first = *newNode;
+            last  = first + blockSize();
+        }
+
+        Ref operator*() const { return *cur; }
+        Ptr operator->() const { return cur; }
+
+        difference_type operator-(const self& x) const {
+            if (node == x.node) {
+                return cur - x.cur;
+            }
+            return difference_type(blockSize()) * (node - x.node - 1) +
+                   (cur - first) + (x.last - x.cur);
+        }
+
+        self& operator++() {
+            ++cur;
+            if (cur == last) {
+                setNode(node + 1);
+                cur = first;
+            }
+            return *this;
+        }
+        self operator++(int) {
+            self tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        self& operator--() {
+            if (cur == first) {
+                setNode(node - 1);
+                cur = last;
+            }
+            --cur;
+            return *this;
+        }
+        self operator--(int) {
+            self tmp = *this;
+            --*this;
+            return tmp;
+        }
+
+        self& operator+=(difference_type n) {
+            difference_type bs     = blockSize();
+            difference_type offset = n + (cur - first);
+            if (offset >= 0 && offset < bs) {
+                cur += n;
+            } else {
+                difference_type nodeOffset =
+                    offset > 0 ? offset / bs : -((-offset - 1) / bs) - 1;
+                setNode(node + nodeOffset);
+                cur = first + (offset - nodeOffset * bs);
+            }
+            return *this;
+        }
+        self operator+(difference_type n) const {
+            self tmp = *this;
+            return tmp += n;
+        }
+        self& operator-=(difference_type n) { return *this += -n; }
+        self operator-(difference_type n) const {
+            self tmp = *this;
+            return tmp -= n;
+        }
+
+        Ref operator[](difference_type n) const { return *(*this + n); }
+
+        bool operator==(const self& x) const { return cur == x.cur; }
+        bool operator!=(const self& x) const { return !(*this == x); }
+        bool operator<(const self& x) const {
+            return node == x.node ? cur < x.cur : node < x.node;
+        }
+        bool operator>(const self& x) const { return x < *this; }
+        bool operator<=(const self& x) const { return !(x < *this); }
+        bool operator>=(const self& x) const { return !(*this < x); }
+    };
+
+    template <typename T, typename Ref, typename Ptr>
+    deque_iterator<T, Ref, Ptr> operator+(std::ptrdiff_t n, const deque_iterator<T, Ref, Ptr>& x) {
+        return x + n;
+    }
+
+    template <typename T, typename Alloc = TinySTL::allocator<T>>
+    class deque {
+       public:
+        using value_type      = T;
+        using allocator_type  = Alloc;
+        using reference       = value_type&;
+        using const_reference = const value_type&;
+        using pointer         = value_type*;
+        using const_pointer   = const value_type*;
+        using iterator        = deque_iterator<T, T&, T*>;
+        using const_iterator  = deque_iterator<T, const T&, const T*>;
+        using difference_type = std::ptrdiff_t;
+        using size_type       = std::size_t;
+
+       public:
+        // Initialize
+        explicit deque(const allocator_type& alloc = allocator_type());  // default (1)
+
+        explicit deque(size_type n);                                     // fill (2)
+                 deque(size_type n, const value_type& val,
+                       const allocator_type& alloc = allocator_type());
+
+        template <typename InputIterator, typename = typename TinySTL::Iterator::iterator_traits<InputIterator>::value_type>
+        deque(InputIterator first, InputIterator last,
+              const allocator_type& alloc = allocator_type());     // range (3)
+
+        deque(const deque& x);                                     // copy (4)
+
+        deque(deque&& x);                                          // move (5)
+
+        deque(std::initializer_list<value_type> il,
+              const allocator_type& alloc = allocator_type());     // initializer list (6)
+
+        ~deque();
+
+        deque& operator=(const deque& rhs);
+        deque& operator=(deque&& rhs);
+
+        // Iterators:
+              iterator begin() noexcept        { return start; }
+        const_iterator begin() const noexcept  { return start; }
+              iterator end()   noexcept        { return finish; }
+        const_iterator end()   const noexcept  { return finish; }
+        const_iterator cbegin() const noexcept { return start; }
+        const_iterator cend()   const noexcept { return finish; }
+
+        // Capacity
+        size_type size() const noexcept     { return finish - start; }
+        size_type max_size() const noexcept { return (~(size_t)0); }
+        void resize(size_type n);
+        void resize(size_type n, const value_type& val);
+        bool empty() const noexcept         { return finish == start; }
+
+        // Element access:
+              reference operator[] (size_type n)        { return start[difference_type(n)]; }
+        const_reference operator[] (size_type n) const  { return start[difference_type(n)]; }
+              reference at (size_type n);
+        const_reference at (size_type n) const;
+              reference front()         { return *start; }
+        const_reference front() const   { return *start; }
+              reference back()          { return *(finish - 1); }
+        const_reference back() const    { return *(finish - 1); }
+
+        // Modifiers
+        void push_back(const value_type& val)  { emplace_back(val); }
+        void push_back(value_type&& val)       { emplace_back(std::move(val)); }
+        void push_front(const value_type& val) { emplace_front(val); }
+        void push_front(value_type&& val)      { emplace_front(std::move(val)); }
+
+        template <class... Args>
+        void emplace_back(Args&&... args);
+        template <class... Args>
+        void emplace_front(Args&&... args);
+
+        void pop_back();
+        void pop_front();
+
+        iterator insert(const_iterator position, const value_type& val);
+        iterator insert(const_iterator position, value_type&& val);
+
+        iterator erase(const_iterator position);
+        iterator erase(const_iterator first, const_iterator last);
+
+        void swap(deque& x);
+
+        void clear();
+
+        // Allocator
+        allocator_type get_allocator() const noexcept { return alloc; }
+
+       private:
+        using map_pointer    = T**;
+        using map_allocator  = typename Alloc::template rebind<T*>::other;
+
+        static size_type blockSize() { return iterator::blockSize(); }
+
+        T* allocateBlock()            { return alloc.allocate(blockSize()); }
+        void deallocateBlock(T* p)    { alloc.deallocate(p, blockSize()); }
+
+        void initializeMap(size_type numElements);
+        void destroyRange(iterator first, iterator last);
+        void reserveMapAtBack(size_type nodesToAdd = 1);
+        void reserveMapAtFront(size_type nodesToAdd = 1);
+        void reallocateMap(size_type nodesToAdd, bool addAtFront);
+
+       private:
+        // data stored in [start, finish), blocks [start.node, finish.node]
+        // are allocated, map holds mapSize block pointers
+        iterator start, finish;
+        map_pointer map;
+        size_type mapSize;
+        allocator_type alloc;
+        map_allocator mapAlloc;
+    };
+
+    // Non-member function overloads
+    template <typename T, typename Alloc>
+    void swap(deque<T, Alloc>& lhs, deque<T, Alloc>& rhs);
+
+    template <typename T, typename Alloc>
+    bool operator == (const deque<T, Alloc>& lhs, const deque<T, Alloc>& rhs);
+    template <typename T, typename Alloc>
+    bool operator != (const deque<T, Alloc>& lhs, const deque<T, Alloc>& rhs);
+
+}  // namespace TinySTL
+
+
 namespace TinySTL {
 
+    template <typename T, typename Alloc>
+    deque<T, Alloc>::deque(const allocator_type& alloc_)
+        : map(nullptr), mapSize(0), alloc(alloc_), mapAlloc(alloc_) {
+        initializeMap(0);
+    }
+
+    template <typename T, typename Alloc>
+    deque<T, Alloc>::deque(size_type n)
+        : deque() {
+        resize(n);
+    }
+
+    template <typename T, typename Alloc>
+    deque<T, Alloc>::deque(size_type n, const value_type& val, const allocator_type& alloc_)
+        : deque(alloc_) {
+        resize(n, val);
+    }
+
+    template <typename T, typename Alloc>
+    template <typename InputIterator, typename >
+    deque<T, Alloc>::deque(InputIterator first, InputIterator last, const allocator_type& alloc_)
+        : deque(alloc_) {
+        for (; first != last; ++first) {
+            emplace_back(*first);
+        }
+    }
+
+    template <typename T, typename Alloc>
+    deque<T, Alloc>::deque(const deque& x)
+        : map(nullptr), mapSize(0), alloc(x.alloc), mapAlloc(x.alloc) {
+        initializeMap(0);
+        for (const_iterator p = x.begin(); p != x.end(); ++p) {
+            emplace_back(*p);
+        }
+    }
+
+    template <typename T, typename Alloc>
+    deque<T, Alloc>::deque(deque&& x)
+        : map(nullptr), mapSize(0), alloc(x.alloc), mapAlloc(x.alloc) {
+        initializeMap(0);
+        swap(x);
+    }
+
+    template <typename T, typename Alloc>
+    deque<T, Alloc>::deque(std::initializer_list<value_type> il, const allocator_type& alloc_)
+        : deque(il.begin(), il.end(), alloc_) {
+    }
+
+    template <typename T, typename Alloc>
+    deque<T, Alloc>::~deque() {
+        clear();
+        deallocateBlock(*start.node);
+        mapAlloc.deallocate(map, mapSize);
+    }
+
+    template <typename T, typename Alloc>
+    deque<T, Alloc>& deque<T, Alloc>::operator=(const deque& x) {
+        if (&x != this) {
+            deque tmp(x);
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    template <typename T, typename Alloc>
+    deque<T, Alloc>& deque<T, Alloc>::operator=(deque&& x) {
+        if (&x != this) {
+            clear();
+            swap(x);
+        }
+        return *this;
+    }
+
+    template <typename T, typename Alloc>
+    void deque<T, Alloc>::resize(size_type n) {
+        while (size() > n) {
+            pop_back();
+        }
+        while (size() < n) {
+            emplace_back();
+        }
+    }
+
+    template <typename T, typename Alloc>
+    void deque<T, Alloc>::resize(size_type n, const value_type& val) {
+        while (size() > n) {
+            pop_back();
+        }
+        while (size() < n) {
+            emplace_back(val);
+        }
+    }
+
+    template <typename T, typename Alloc>
+    typename deque<T, Alloc>::reference deque<T, Alloc>::at(size_type n) {
+        if (n >= size()) {
+            throw std::out_of_range("index is out of range");
+        }
+        return (*this)[n];
+    }
+
+    template <typename T, typename Alloc>
+    typename deque<T, Alloc>::const_reference deque<T, Alloc>::at(size_type n) const {
+        if (n >= size()) {
+            throw std::out_of_range("index is out of range");
+        }
+        return (*this)[n];
+    }
+
+    template <typename T, typename Alloc>
+    template <class... Args>
+    void deque<T, Alloc>::emplace_back(Args&&... args) {
+        if (finish.cur != finish.last - 1) {
+            alloc.construct(finish.cur, std::forward<Args>(args)...);
+            ++finish.cur;
+            return;
+        }
+        // last slot of the block: make sure the next block exists first
+        reserveMapAtBack();
+        *(finish.node + 1) = allocateBlock();
+        try {
+            alloc.construct(finish.cur, std::forward<Args>(args)...);
+        } catch (...) {
+            deallocateBlock(*(finish.node + 1));
+            throw;
+        }
+        finish.setNode(finish.node + 1);
+        finish.cur = finish.first;
+    }
+
+    template <typename T, typename Alloc>
+    template <class... Args>
+    void deque<T, Alloc>::emplace_front(Args&&... args) {
+        if (start.cur != start.first) {
+            alloc.construct(start.cur - 1, std::forward<Args>(args)...);
+            --start.cur;
+            return;
+        }
+        reserveMapAtFront();
+        *(start.node - 1) = allocateBlock();
+        T* slot = *(start.node - 1) + blockSize() - 1;
+        try {
+            alloc.construct(slot, std::forward<Args>(args)...);
+        } catch (...) {
+            deallocateBlock(*(start.node - 1));
+            throw;
+        }
+        start.setNode(start.node - 1);
+        start.cur = slot;
+    }
+
+    template <typename T, typename Alloc>
+    void deque<T, Alloc>::pop_back() {
+        if (empty()) {
+            return;
+        }
+        if (finish.cur == finish.first) {
+            deallocateBlock(finish.first);
+            finish.setNode(finish.node - 1);
+            finish.cur = finish.last;
+        }
+        --finish.cur;
+        alloc.destroy(finish.cur);
+    }
+
+    template <typename T, typename Alloc>
+    void deque<T, Alloc>::pop_front() {
+        if (empty()) {
+            return;
+        }
+        alloc.destroy(start.cur);
+        if (start.cur != start.last - 1) {
+            ++start.cur;
+        } else {
+            deallocateBlock(start.first);
+            start.setNode(start.node + 1);
+            start.cur = start.first;
+        }
+    }
+
+    template <typename T, typename Alloc>
+    typename deque<T, Alloc>::iterator
+    deque<T, Alloc>::insert(const_iterator position, const value_type& val) {
+        return insert(position, value_type(val));
+    }
+
+    template <typename T, typename Alloc>
+    typename deque<T, Alloc>::iterator
+    deque<T, Alloc>::insert(const_iterator position, value_type&& val) {
+        difference_type index = position - const_iterator(start);
+        if (index == 0) {
+            emplace_front(std::move(val));
+            return start;
+        }
+        if (size_type(index) < size() / 2) {
+            // shift the front half one slot towards the front
+            emplace_front(std::move(front()));
+            iterator p = start + 1;
+            iterator pos = start + index;
+            for (; p != pos; ++p) {
+                *p = std::move(*(p + 1));
+            }
+            *pos = std::move(val);
+            return pos;
+        }
+        if (size_type(index) == size()) {
+            emplace_back(std::move(val));
+            return finish - 1;
+        }
+        emplace_back(std::move(back()));
+        iterator pos = start + index;
+        for (iterator p = finish - 2; p != pos; --p) {
+            *p = std::move(*(p - 1));
+        }
+        *pos = std::move(val);
+        return pos;
+    }
+
+    template <typename T, typename Alloc>
+    typename deque<T, Alloc>::iterator
+    deque<T, Alloc>::erase(const_iterator position) {
+        return erase(position, position + 1);
+    }
+
+    template <typename T, typename Alloc>
+    typename deque<T, Alloc>::iterator
+    deque<T, Alloc>::erase(const_iterator first, const_iterator last) {
+        difference_type index = first - const_iterator(start);
+        difference_type n     = last - first;
+        if (n == 0) {
+            return start + index;
+        }
+        if (size_type(index) < (size() - n) / 2) {
+            // fewer elements before the gap: move them back and pop the front
+            for (iterator dst = start + (index + n), src = start + index; src != start;) {
+                --dst;
+                --src;
+                *dst = std::move(*src);
+            }
+            for (difference_type i = 0; i < n; i++) {
+                pop_front();
+            }
+        } else {
+            iterator dst = start + index;
+            for (iterator src = start + (index + n); src != finish; ++src, ++dst) {
+                *dst = std::move(*src);
+            }
+            for (difference_type i = 0; i < n; i++) {
+                pop_back();
+            }
+        }
+        return start + index;
+    }
+
+    template <typename T, typename Alloc>
+    void deque<T, Alloc>::swap(deque& x) {
+        std::swap(start, x.start);
+        std::swap(finish, x.finish);
+        std::swap(map, x.map);
+        std::swap(mapSize, x.mapSize);
+        std::swap(alloc, x.alloc);
+        std::swap(mapAlloc, x.mapAlloc);
+    }
+
+    template <typename T, typename Alloc>
+    void deque<T, Alloc>::clear() {
+        destroyRange(start, finish);
+        // keep the first block so the deque stays usable
+        for (map_pointer node = start.node + 1; node <= finish.node; ++node) {
+            deallocateBlock(*node);
+        }
+        start.cur = start.first;
+        finish = start;
+    }
+
+    template <typename T, typename Alloc>
+    void deque<T, Alloc>::initializeMap(size_type numElements) {
+        size_type numNodes = numElements / blockSize() + 1;
+        mapSize = numNodes + 2 < 8 ? 8 : numNodes + 2;
+        map = mapAlloc.allocate(mapSize);
+
+        // center the used nodes so both ends can grow
+        map_pointer nstart  = map + (mapSize - numNodes) / 2;
+        map_pointer nfinish = nstart + numNodes - 1;
+        for (map_pointer cur = nstart; cur <= nfinish; ++cur) {
+            *cur = allocateBlock();
+        }
+        start.setNode(nstart);
+        start.cur = start.first;
+        finish.setNode(nfinish);
+        finish.cur = finish.first + numElements % blockSize();
+    }
+
+    template <typename T, typename Alloc>
+    void deque<T, Alloc>::destroyRange(iterator first, iterator last) {
+        for (; first != last; ++first) {
+            alloc.destroy(first.cur);
+        }
+    }
+
+    template <typename T, typename Alloc>
+    void deque<T, Alloc>::reserveMapAtBack(size_type nodesToAdd) {
+        if (nodesToAdd + 1 > mapSize - (finish.node - map)) {
+            reallocateMap(nodesToAdd, false);
+        }
+    }
+
+    template <typename T, typename Alloc>
+    void deque<T, Alloc>::reserveMapAtFront(size_type nodesToAdd) {
+        if (nodesToAdd > size_type(start.node - map)) {
+            reallocateMap(nodesToAdd, true);
+        }
+    }
+
+    template <typename T, typename Alloc>
+    void deque<T, Alloc>::reallocateMap(size_type nodesToAdd, bool addAtFront) {
+        size_type oldNumNodes = finish.node - start.node + 1;
+        size_type newNumNodes = oldNumNodes + nodesToAdd;
+
+        map_pointer newStart;
+        if (mapSize > 2 * newNumNodes) {
+            // plenty of room, just recenter the block pointers
+            newStart = map + (mapSize - newNumNodes) / 2 + (addAtFront ? nodesToAdd : 0);
+            if (newStart < start.node) {
+                for (size_type i = 0; i < oldNumNodes; i++) {
+                    newStart[i] = start.node[i];
+                }
+            } else {
+                for (size_type i = oldNumNodes; i > 0; i--) {
+                    newStart[i - 1] = start.node[i - 1];
+                }
+            }
+        } else {
+            size_type newMapSize = mapSize + (mapSize > nodesToAdd ? mapSize : nodesToAdd) + 2;
+            map_pointer newMap   = mapAlloc.allocate(newMapSize);
+            newStart = newMap + (newMapSize - newNumNodes) / 2 + (addAtFront ? nodesToAdd : 0);
+            for (size_type i = 0; i < oldNumNodes; i++) {
+                newStart[i] = start.node[i];
+            }
+            mapAlloc.deallocate(map, mapSize);
+            map     = newMap;
+            mapSize = newMapSize;
+        }
+
+        // the blocks did not move, only the slots pointing at them
+        difference_type startOffset  = start.cur - start.first;
+        difference_type finishOffset = finish.cur - finish.first;
+        start.setNode(newStart);
+        start.cur = start.first + startOffset;
+        finish.setNode(newStart + oldNumNodes - 1);
+        finish.cur = finish.first + finishOffset;
+    }
+
+    template <typename T, typename Alloc>
+    void swap(deque<T, Alloc>& lhs, deque<T, Alloc>& rhs) {
+        lhs.swap(rhs);
+    }
+
+    template <typename T, typename Alloc>
+    bool operator==(const deque<T, Alloc>& lhs, const deque<T, Alloc>& rhs) {
+        if (lhs.size() != rhs.size()) {
+            return false;
+        }
+        typename deque<T, Alloc>::const_iterator p = lhs.begin(), q = rhs.begin();
+        for (; p != lhs.end(); ++p, ++q) {
+            if (*p != *q)
+                return false;
+        }
+        return true;
+    }
+
+    template <typename T, typename Alloc>
+    bool operator!=(const deque<T, Alloc>& lhs, const deque<T, Alloc>& rhs) {
+        return !(lhs == rhs);
+    }
 
-} // namespace TinySTL 
+}  // namespace TinySTL
 
 
-#endif // DEQUE_HPP
\ No newline at end of file
+#endif  // DEQUE_HPP
@@ -7,6 +7,48 @@ namespace TinySTL {
 
 template <typename VertexType, typename EdgeType>
 class Graph {
+   public:
+    // Generic neighbour range built on the virtual edge cursor below.
+    // Every step is a virtual call, so implementations hide neighbours()
+    // with a linear, inlinable version; this one only serves code that
+    // holds a plain Graph reference.
+    struct Neighbour {
+        int dest;
+        EdgeType weight;
+    };
+
+    class NeighbourIterator {
+       public:
+        NeighbourIterator(Graph *graph, int v, const void *pos) : graph(graph), v(v), pos(pos) {}
+        Neighbour operator*() const { return graph->edgeAt(v, pos); }
+        NeighbourIterator &operator++() {
+            pos = graph->nextEdge(v, pos);
+            return *this;
+        }
+        bool operator==(const NeighbourIterator &x) const { return pos == x.pos; }
+        bool operator!=(const NeighbourIterator &x) const { return pos != x.pos; }
+
+       private:
+        Graph *graph;
+        int v;
+        const void *pos;
+    };
+
+    class NeighbourRange {
+       public:
+        NeighbourRange(Graph *graph, int v) : graph(graph), v(v) {}
+        NeighbourIterator begin() const { return NeighbourIterator(graph, v, graph->firstEdge(v)); }
+        NeighbourIterator end() const { return NeighbourIterator(graph, v, nullptr); }
+
+       private:
+        Graph *graph;
+        int v;
+    };
+
+   public:
+    using vertex_type = VertexType;
+    using edge_type = EdgeType;
+
    public:
     Graph() : numEdges(0), numVertices(0) {}
     Graph(const Graph &rhs) {
@@ -31,6 +73,16 @@ class Graph {
     virtual int getFirstNeighbour(int v) = 0;
     virtual int getNextNeighbour(int v1, int v2) = 0;
 
+    // Edge cursor: an opaque position of one out-edge of v, nullptr past
+    // the last. Unlike getNextNeighbour it steps over parallel edges one
+    // at a time. Positions are invalidated by any modification.
+    virtual const void *firstEdge(int v) const = 0;
+    virtual const void *nextEdge(int v, const void *pos) const = 0;
+    virtual Neighbour edgeAt(int v, const void *pos) const = 0;
+
+    // for (auto e : g.neighbours(v)) visits e.dest / e.weight
+    NeighbourRange neighbours(int v) { return NeighbourRange(this, v); }
+
    protected:
     size_t numEdges;
     size_t numVertices;
@@ -2,13 +2,24 @@
 #define GRAPH_ADJ_HPP
 
 // Graph implemented by adjacency list
-
+//
+// Edge nodes come from a fixed_pool owned by the graph rather than from
+// one new/delete each: building, copying and reversing only carve nodes
+// out of chunks, and destruction hands back the chunks in bulk. Chunks
+// start at 16 nodes and double up to 4096, a copy takes a single chunk
+// sized for its edges, and the chunks are also returned whenever the
+// last edge is removed.
+
+#include "Allocator.hpp"
 #include "Graph.hpp"
 
 #include <cassert>
 #include <cstdio>
 #include <cstdlib>
 #include <iostream>
+#include <new>
+#include <type_traits>
+#include <unordered_map>
 
 using namespace std;
 
@@ -24,16 +35,89 @@ struct Edge {
         : dest(dest), weight(weight), next(nullptr) {}
 };
 
+// inEdge and inDegree are only maintained in bidirectional mode; the
+// nodes of the inEdge list hold the source of each edge in dest
 template <typename VertexType, typename EdgeType>
 struct Vertex {
     VertexType data;
     Edge<VertexType, EdgeType> *outEdge;
-    Vertex() : data(VertexType()), outEdge(nullptr) {}
-    explicit Vertex(const VertexType &v) : data(v), outEdge(nullptr) {}
+    Edge<VertexType, EdgeType> *inEdge;
+    size_t inDegree;
+    Vertex() : data(VertexType()), outEdge(nullptr), inEdge(nullptr), inDegree(0) {}
+    explicit Vertex(const VertexType &v)
+        : data(v), outEdge(nullptr), inEdge(nullptr), inDegree(0) {}
+};
+
+// Value -> position index for GraphAdj. The graph holds it through a
+// pointer and only enableVertexIndex() creates the hashing implementation,
+// so vertex types without std::hash work as long as it is never enabled.
+template <typename VertexType>
+class VertexIndex {
+   public:
+    virtual ~VertexIndex() {}
+    virtual VertexIndex *clone() const = 0;
+    virtual int find(const VertexType &vertex) const = 0;  // -1 if absent
+    virtual bool insert(const VertexType &vertex, int pos) = 0;  // false if present
+    virtual void assign(const VertexType &vertex, int pos) = 0;
+    virtual void erase(const VertexType &vertex) = 0;
+};
+
+template <typename VertexType>
+class HashVertexIndex : public VertexIndex<VertexType> {
+   public:
+    explicit HashVertexIndex(size_t n) { index.reserve(n); }
+    virtual VertexIndex<VertexType> *clone() const override { return new HashVertexIndex(*this); }
+    virtual int find(const VertexType &vertex) const override {
+        auto it = index.find(vertex);
+        return it == index.end() ? -1 : it->second;
+    }
+    virtual bool insert(const VertexType &vertex, int pos) override {
+        return index.emplace(vertex, pos).second;
+    }
+    virtual void assign(const VertexType &vertex, int pos) override { index[vertex] = pos; }
+    virtual void erase(const VertexType &vertex) override { index.erase(vertex); }
+
+   private:
+    std::unordered_map<VertexType, int> index;
 };
 
+template <typename VertexType, typename EdgeType>
+class GraphCSR;
+
 template <typename VertexType, typename EdgeType = int>
 class GraphAdj : public Graph<VertexType, EdgeType> {
+    friend class GraphCSR<VertexType, EdgeType>;
+
+   public:
+    // Walks the out-edge list of one vertex; yields the Edge nodes
+    // themselves, so e.dest and e.weight are plain member reads.
+    class NeighbourIterator {
+       public:
+        explicit NeighbourIterator(const Edge<VertexType, EdgeType> *p) : p(p) {}
+        const Edge<VertexType, EdgeType> &operator*() const { return *p; }
+        const Edge<VertexType, EdgeType> *operator->() const { return p; }
+        NeighbourIterator &operator++() {
+            p = p->next;
+            return *this;
+        }
+        bool operator==(const NeighbourIterator &x) const { return p == x.p; }
+        bool operator!=(const NeighbourIterator &x) const { return p != x.p; }
+
+       private:
+        const Edge<VertexType, EdgeType> *p;
+    };
+
+    class NeighbourRange {
+       public:
+        explicit NeighbourRange(const Edge<VertexType, EdgeType> *head) : head(head) {}
+        NeighbourIterator begin() const { return NeighbourIterator(head); }
+        NeighbourIterator end() const { return NeighbourIterator(nullptr); }
+        bool empty() const { return head == nullptr; }
+
+       private:
+        const Edge<VertexType, EdgeType> *head;
+    };
+
    public:
     GraphAdj();
     GraphAdj(const GraphAdj &rhs);
@@ -55,16 +139,54 @@ class GraphAdj : public Graph<VertexType, EdgeType> {
     virtual int getFirstNeighbour(int v) override;
     virtual int getNextNeighbour(int v1, int v2) override;
 
+    virtual const void *firstEdge(int v) const override;
+    virtual const void *nextEdge(int v, const void *pos) const override;
+    virtual typename Graph<VertexType, EdgeType>::Neighbour edgeAt(int v, const void *pos) const override;
+
+    // for (auto &e : g.neighbours(v)) visits e.dest / e.weight in O(deg)
+    NeighbourRange neighbours(int v) const;
+    // the edges into v, e.dest being their source; bidirectional mode only
+    NeighbourRange predecessors(int v) const;
+
     void reverse();
 
+    // getVertexPos scans every vertex unless the vertex index is enabled:
+    // then it is a hash lookup, kept up to date by insertVertex and
+    // removeVertex. Indexed vertex values must be distinct and hashable.
+    void enableVertexIndex(bool enable = true);
+    bool vertexIndexEnabled() const { return vertexIndex != nullptr; }
+
+    // Bidirectional mode also keeps a list of in-edges per vertex, so
+    // getInDegree is O(1), predecessors(v) is O(in-degree) and
+    // removeVertex only visits the lists of v's neighbours instead of
+    // every list, at the price of a second node per edge.
+    void enableInEdges(bool enable = true);
+    bool inEdgesEnabled() const { return bidirectional; }
+
    protected:
     Vertex<VertexType, EdgeType> *adj;
     size_t maxVertices;
+    VertexIndex<VertexType> *vertexIndex;  // nullptr unless enabled
+    bool bidirectional;
+    fixed_pool edgePool;  // every Edge node of the graph
     using Graph<VertexType, EdgeType>::numVertices;
     using Graph<VertexType, EdgeType>::numEdges;
 
    private:
     void overflowHandle();
+    // bidirectional mode: renames vertex from to to in its neighbours' lists
+    void renumberMovedVertex(int from, int to);
+
+    Edge<VertexType, EdgeType> *newEdge(int dest, const EdgeType &weight);
+    void deleteEdge(Edge<VertexType, EdgeType> *p);
+    // destroys every edge node and returns the pool's chunks at once
+    void destroyEdges();
+    Edge<VertexType, EdgeType> *copyList(const Edge<VertexType, EdgeType> *p);
+    void freeList(Edge<VertexType, EdgeType> *p);
+    // unlinks the first node of the list leading to dest, false if none
+    bool unlinkEdge(Edge<VertexType, EdgeType> *&head, int dest);
+    // points the first node of the list leading to from at to instead
+    static void redirectEdge(Edge<VertexType, EdgeType> *head, int from, int to);
 
     // for debugging/testing
    public:
@@ -73,14 +195,20 @@ class GraphAdj : public Graph<VertexType, EdgeType> {
 };
 
 template <typename V, typename E>
-GraphAdj<V, E>::GraphAdj() : Graph<V, E>() {
+GraphAdj<V, E>::GraphAdj() : Graph<V, E>(), edgePool(sizeof(Edge<V, E>), 16, 4096) {
     adj = nullptr;
     maxVertices = 0;
+    vertexIndex = nullptr;
+    bidirectional = false;
 }
 
 template <typename V, typename E>
-inline GraphAdj<V, E>::GraphAdj(const GraphAdj &rhs) : Graph<V, E>(rhs) {
+inline GraphAdj<V, E>::GraphAdj(const GraphAdj &rhs)
+    : Graph<V, E>(rhs),
+      vertexIndex(rhs.vertexIndex == nullptr ? nullptr : rhs.vertexIndex->clone()),
+      bidirectional(rhs.bidirectional), edgePool(sizeof(Edge<V, E>), 16, 4096) {
     maxVertices = rhs.maxVertices;
+    edgePool.add_chunk(bidirectional ? 2 * numEdges : numEdges);
     if (rhs.adj == nullptr) {
         adj = nullptr;
         // assert(maxVertices == 0);
@@ -88,21 +216,9 @@ inline GraphAdj<V, E>::GraphAdj(const GraphAdj &rhs) : Graph<V, E>(rhs) {
         adj = new Vertex<V, E>[maxVertices];
         for (size_t i = 0; i < numVertices; i++) {
             adj[i].data = rhs.adj[i].data;
-            adj[i].outEdge = nullptr;
-            Edge<V, E> *tail = nullptr;
-            Edge<V, E> *p = rhs.adj[i].outEdge;
-            while (p != nullptr) {
-                Edge<V, E> *q = new Edge<V, E>(p->dest, p->weight);
-                // assert(q->next == nullptr);
-                if (adj[i].outEdge == nullptr) {
-                    tail = q;
-                    adj[i].outEdge = q;
-                } else {
-                    tail->next = q;
-                    tail = q;
-                }
-                p = p->next;
-            }
+            adj[i].outEdge = copyList(rhs.adj[i].outEdge);
+            adj[i].inEdge = copyList(rhs.adj[i].inEdge);
+            adj[i].inDegree = rhs.adj[i].inDegree;
         }
     }
 }
@@ -110,7 +226,15 @@ inline GraphAdj<V, E>::GraphAdj(const GraphAdj &rhs) : Graph<V, E>(rhs) {
 template <typename V, typename E>
 inline GraphAdj<V, E> &GraphAdj<V, E>::operator=(const GraphAdj &rhs) {
     if (this != &rhs) {
+        destroyEdges();
+        delete[] adj;
+        numVertices = rhs.numVertices;
+        numEdges = rhs.numEdges;
         maxVertices = rhs.maxVertices;
+        delete vertexIndex;
+        vertexIndex = rhs.vertexIndex == nullptr ? nullptr : rhs.vertexIndex->clone();
+        bidirectional = rhs.bidirectional;
+        edgePool.add_chunk(bidirectional ? 2 * numEdges : numEdges);
         if (rhs.adj == nullptr) {
             adj = nullptr;
             // assert(maxVertices == 0);
@@ -118,21 +242,9 @@ inline GraphAdj<V, E> &GraphAdj<V, E>::operator=(const GraphAdj &rhs) {
             adj = new Vertex<V, E>[maxVertices];
             for (size_t i = 0; i < numVertices; i++) {
                 adj[i].data = rhs.adj[i].data;
-                adj[i].outEdge = nullptr;
-                Edge<V, E> *tail = nullptr;
-                Edge<V, E> *p = rhs.adj[i].outEdge;
-                while (p != nullptr) {
-                    Edge<V, E> *q = new Edge<V, E>(p->dest, p->weight);
-                    // assert(q->next == nullptr);
-                    if (adj[i].outEdge == nullptr) {
-                        tail = q;
-                        adj[i].outEdge = q;
-                    } else {
-                        tail->next = q;
-                        tail = q;
-                    }
-                    p = p->next;
-                }
+                adj[i].outEdge = copyList(rhs.adj[i].outEdge);
+                adj[i].inEdge = copyList(rhs.adj[i].inEdge);
+                adj[i].inDegree = rhs.adj[i].inDegree;
             }
         }
     }
@@ -141,23 +253,16 @@ inline GraphAdj<V, E> &GraphAdj<V, E>::operator=(const GraphAdj &rhs) {
 
 template <typename V, typename E>
 GraphAdj<V, E>::~GraphAdj() {
-    if (adj != nullptr) {
-        for (size_t i = 0; i < numVertices; i++) {
-            Edge<V, E> *p = nullptr;
-            Edge<V, E> *q = adj[i].outEdge;
-            while (q != nullptr) {
-                p = q;
-                q = q->next;
-                delete p;
-            }
-        }
-        delete[] adj;
-    }
+    destroyEdges();
+    delete[] adj;
+    delete vertexIndex;
 }
 
 template <typename V, typename E>
 int GraphAdj<V, E>::getVertexPos(const V &vertex) {
-    assert(adj != nullptr);
+    if (vertexIndex != nullptr) {
+        return vertexIndex->find(vertex);
+    }
     for (size_t i = 0; i < numVertices; i++) {
         if (adj[i].data == vertex) {
             return i;
@@ -201,8 +306,11 @@ size_t GraphAdj<V, E>::getOutDegree(int v) const {
 
 template <typename V, typename E>
 size_t GraphAdj<V, E>::getInDegree(int v) const {
-    // O(V + E) rather slow
     assert(0 <= v && v < (int)numVertices);
+    if (bidirectional) {
+        return adj[v].inDegree;
+    }
+    // O(V + E) rather slow
     int indegree = 0;
     for (size_t i = 0; i < this->numVertices; i++) {
         Edge<V, E> *p = adj[i].outEdge;
@@ -221,6 +329,11 @@ void GraphAdj<V, E>::insertVertex(const V &vertex) {
     if (numVertices == maxVertices) {
         overflowHandle();
     }
+    if (vertexIndex != nullptr) {
+        bool inserted = vertexIndex->insert(vertex, (int)numVertices);
+        assert(inserted);  // indexed values must be distinct
+        (void)inserted;
+    }
     adj[numVertices] = Vertex<V, E>(vertex);
     numVertices++;
     return;
@@ -230,9 +343,15 @@ template <typename V, typename E>
 void GraphAdj<V, E>::insertEdge(int v1, int v2, const E &weight) {
     assert(0 <= v1 && v1 < (int)numVertices);
     assert(0 <= v2 && v2 < (int)numVertices);
-    Edge<V, E> *p = new Edge<V, E>(v2, weight);
+    Edge<V, E> *p = newEdge(v2, weight);
     p->next = adj[v1].outEdge;
     adj[v1].outEdge = p;
+    if (bidirectional) {
+        Edge<V, E> *q = newEdge(v1, weight);
+        q->next = adj[v2].inEdge;
+        adj[v2].inEdge = q;
+        adj[v2].inDegree++;
+    }
     numEdges++;
     return;
 }
@@ -240,49 +359,103 @@ void GraphAdj<V, E>::insertEdge(int v1, int v2, const E &weight) {
 template <typename V, typename E>
 void GraphAdj<V, E>::removeVertex(int v) {
     assert(0 <= v && v < (int)numVertices);
+    int last = numVertices - 1;
     int cnt = 0;
 
-    // remove vertex v
-    Edge<V, E> *p = nullptr;
-    Edge<V, E> *q = adj[v].outEdge;
-    while (q != nullptr) {
-        cnt++;
-        p = q;
-        q = q->next;
-        delete p;
-    }
-    adj[v] = adj[numVertices - 1];
-    assert(adj[v].outEdge == adj[numVertices - 1].outEdge);
-    numVertices--;
-
-    // remove edges concerning vertex v
-    for (size_t i = 0; i < numVertices; i++) {
-        p = nullptr;
-        q = adj[i].outEdge;
-        while (q != nullptr) {
-            if (q->dest == v) {
+    if (bidirectional) {
+        // only the lists of v's neighbours hold edges concerning v
+        for (Edge<V, E> *p = adj[v].outEdge; p != nullptr; p = p->next) {
+            cnt++;
+            if (p->dest != v) {
+                unlinkEdge(adj[p->dest].inEdge, v);
+                adj[p->dest].inDegree--;
+            }
+        }
+        for (Edge<V, E> *p = adj[v].inEdge; p != nullptr; p = p->next) {
+            if (p->dest != v) {
                 cnt++;
-                if (p == nullptr) {
-                    adj[i].outEdge = q->next;
+                unlinkEdge(adj[p->dest].outEdge, v);
+            }
+        }
+        freeList(adj[v].outEdge);
+        freeList(adj[v].inEdge);
+    } else {
+        // remove vertex v
+        Edge<V, E> *p = nullptr;
+        Edge<V, E> *q = adj[v].outEdge;
+        while (q != nullptr) {
+            cnt++;
+            p = q;
+            q = q->next;
+            deleteEdge(p);
+        }
+
+        // remove edges concerning vertex v, and renumber the edges into
+        // the last vertex, which is about to move into slot v
+        for (size_t i = 0; i < numVertices; i++) {
+            if ((int)i == v) {
+                continue;
+            }
+            p = nullptr;
+            q = adj[i].outEdge;
+            while (q != nullptr) {
+                if (q->dest == v) {
+                    cnt++;
+                    if (p == nullptr) {
+                        adj[i].outEdge = q->next;
+                        p = q;
+                        q = q->next;
+                        deleteEdge(p);
+                        p = nullptr;
+                    } else {
+                        p->next = q->next;
+                        deleteEdge(q);
+                        q = p->next;
+                    }
+                } else {
+                    if (q->dest == last) {
+                        q->dest = v;
+                    }
                     p = q;
                     q = q->next;
-                    delete p;
-                    p = nullptr;
-                } else {
-                    p->next = q->next;
-                    delete q;
-                    q = p->next;
                 }
-            } else {
-                p = q;
-                q = q->next;
             }
         }
     }
     numEdges -= cnt;
+    if (numEdges == 0) {
+        edgePool.release();  // every node is free
+    }
+
+    // the last vertex moves into slot v
+    if (vertexIndex != nullptr) {
+        vertexIndex->erase(adj[v].data);
+        if (v != last) {
+            vertexIndex->assign(adj[last].data, v);
+        }
+    }
+    adj[v] = adj[last];
+    numVertices--;
+    if (bidirectional && v != last) {
+        renumberMovedVertex(last, v);
+    }
     return;
 }
 
+template <typename V, typename E>
+void GraphAdj<V, E>::renumberMovedVertex(int from, int to) {
+    // The vertex now at slot to was numbered from. Each of its out-edges
+    // has an in-list entry at the target and each in-edge an out-list
+    // entry at the source; a self-loop is renamed in the in-list first,
+    // so the second loop finds it as a predecessor named to.
+    for (Edge<V, E> *p = adj[to].outEdge; p != nullptr; p = p->next) {
+        redirectEdge(adj[p->dest == from ? to : p->dest].inEdge, from, to);
+    }
+    for (Edge<V, E> *p = adj[to].inEdge; p != nullptr; p = p->next) {
+        redirectEdge(adj[p->dest].outEdge, from, to);
+    }
+}
+
 template <typename V, typename E>
 void GraphAdj<V, E>::removeEdge(int v1, int v2) {
     assert(0 <= v1 && v1 < (int)numVertices);
@@ -302,12 +475,18 @@ void GraphAdj<V, E>::removeEdge(int v1, int v2) {
     }
     if (p == nullptr) {  // first edge
         adj[v1].outEdge = q->next;
-        delete q;
     } else {
         p->next = q->next;
-        delete q;
+    }
+    deleteEdge(q);
+    if (bidirectional) {
+        unlinkEdge(adj[v2].inEdge, v1);
+        adj[v2].inDegree--;
     }
     numEdges--;
+    if (numEdges == 0) {
+        edgePool.release();  // every node is free
+    }
     return;
 }
 
@@ -339,35 +518,111 @@ int GraphAdj<V, E>::getNextNeighbour(int v1, int v2) {
     }
 }
 
+template <typename V, typename E>
+const void *GraphAdj<V, E>::firstEdge(int v) const {
+    assert(0 <= v && v < (int)numVertices);
+    return adj[v].outEdge;
+}
+
+template <typename V, typename E>
+const void *GraphAdj<V, E>::nextEdge(int, const void *pos) const {
+    return static_cast<const Edge<V, E> *>(pos)->next;
+}
+
+template <typename V, typename E>
+typename Graph<V, E>::Neighbour GraphAdj<V, E>::edgeAt(int, const void *pos) const {
+    const Edge<V, E> *e = static_cast<const Edge<V, E> *>(pos);
+    return typename Graph<V, E>::Neighbour{e->dest, e->weight};
+}
+
+template <typename V, typename E>
+typename GraphAdj<V, E>::NeighbourRange GraphAdj<V, E>::neighbours(int v) const {
+    assert(0 <= v && v < (int)numVertices);
+    return NeighbourRange(adj[v].outEdge);
+}
+
+template <typename V, typename E>
+typename GraphAdj<V, E>::NeighbourRange GraphAdj<V, E>::predecessors(int v) const {
+    assert(bidirectional);
+    assert(0 <= v && v < (int)numVertices);
+    return NeighbourRange(adj[v].inEdge);
+}
+
 template <typename V, typename E>
 void GraphAdj<V, E>::reverse() {
-    // O(V + E)
-    if (adj != nullptr) {
-        Vertex<V, E> *newAdj = new Vertex<V, E>[this->maxVertices];
-        // reverse each edge <i, p->dest> to <p->dest, i>
-        // and insert to the head of newAdj[p->dest]
-        for (size_t i = 0; i < this->numVertices; i++) {
-            Edge<V, E> *p = adj[i].outEdge;
-            while (p != nullptr) {
-                Edge<V, E> *q = new Edge<V, E>(i, p->weight);
-                q->next = newAdj[p->dest].outEdge;
-                newAdj[p->dest].outEdge = q;
-                p = p->next;
-            }
+    if (bidirectional) {
+        // the in-lists already are the reversed graph: O(V + E) for the
+        // in-degrees, no allocation
+        for (size_t i = 0; i < numVertices; i++) {
+            std::swap(adj[i].outEdge, adj[i].inEdge);
         }
-        // delete old adj
-        for (size_t i = 0; i < this->numVertices; i++) {
-            Edge<V, E> *p = nullptr;
-            Edge<V, E> *q = adj[i].outEdge;
-            while (q != nullptr) {
-                p = q;
-                q = q->next;
-                delete p;
+        for (size_t i = 0; i < numVertices; i++) {
+            adj[i].inDegree = 0;
+        }
+        for (size_t i = 0; i < numVertices; i++) {
+            for (Edge<V, E> *p = adj[i].outEdge; p != nullptr; p = p->next) {
+                adj[p->dest].inDegree++;
             }
         }
-        delete[] adj;
+        return;
+    }
+    // O(V + E) in place: each node <i, dest> is relinked as <dest, i>
+    // at the head of dest's new list
+    if (numVertices == 0) {
+        return;
+    }
+    Edge<V, E> **heads = new Edge<V, E> *[numVertices]();
+    for (size_t i = 0; i < numVertices; i++) {
+        Edge<V, E> *p = adj[i].outEdge;
+        while (p != nullptr) {
+            Edge<V, E> *next = p->next;
+            int dest = p->dest;
+            p->dest = i;
+            p->next = heads[dest];
+            heads[dest] = p;
+            p = next;
+        }
+    }
+    for (size_t i = 0; i < numVertices; i++) {
+        adj[i].outEdge = heads[i];
+    }
+    delete[] heads;
+}
 
-        adj = newAdj;
+template <typename V, typename E>
+void GraphAdj<V, E>::enableVertexIndex(bool enable) {
+    delete vertexIndex;
+    vertexIndex = nullptr;
+    if (enable) {
+        vertexIndex = new HashVertexIndex<V>(maxVertices);
+        for (size_t i = 0; i < numVertices; i++) {
+            bool inserted = vertexIndex->insert(adj[i].data, (int)i);
+            assert(inserted);  // indexed values must be distinct
+            (void)inserted;
+        }
+    }
+}
+
+template <typename V, typename E>
+void GraphAdj<V, E>::enableInEdges(bool enable) {
+    if (enable == bidirectional) {
+        return;
+    }
+    bidirectional = enable;
+    for (size_t i = 0; i < numVertices; i++) {
+        freeList(adj[i].inEdge);
+        adj[i].inEdge = nullptr;
+        adj[i].inDegree = 0;
+    }
+    if (enable) {
+        for (size_t i = 0; i < numVertices; i++) {
+            for (Edge<V, E> *p = adj[i].outEdge; p != nullptr; p = p->next) {
+                Edge<V, E> *q = newEdge(i, p->weight);
+                q->next = adj[p->dest].inEdge;
+                adj[p->dest].inEdge = q;
+                adj[p->dest].inDegree++;
+            }
+        }
     }
 }
 
@@ -388,6 +643,81 @@ void GraphAdj<V, E>::overflowHandle() {
     }
 }
 
+template <typename V, typename E>
+Edge<V, E> *GraphAdj<V, E>::newEdge(int dest, const E &weight) {
+    return new (edgePool.allocate()) Edge<V, E>(dest, weight);
+}
+
+template <typename V, typename E>
+void GraphAdj<V, E>::deleteEdge(Edge<V, E> *p) {
+    p->~Edge<V, E>();
+    edgePool.deallocate(p);
+}
+
+template <typename V, typename E>
+void GraphAdj<V, E>::destroyEdges() {
+    // trivially destructible nodes need no visit at all
+    if (!std::is_trivially_destructible<Edge<V, E> >::value) {
+        for (size_t i = 0; i < numVertices; i++) {
+            for (Edge<V, E> *p = adj[i].outEdge; p != nullptr; p = p->next) {
+                p->~Edge<V, E>();
+            }
+            for (Edge<V, E> *p = adj[i].inEdge; p != nullptr; p = p->next) {
+                p->~Edge<V, E>();
+            }
+        }
+    }
+    edgePool.release();
+}
+
+template <typename V, typename E>
+Edge<V, E> *GraphAdj<V, E>::copyList(const Edge<V, E> *p) {
+    Edge<V, E> *head = nullptr;
+    Edge<V, E> *tail = nullptr;
+    for (; p != nullptr; p = p->next) {
+        Edge<V, E> *q = newEdge(p->dest, p->weight);
+        if (head == nullptr) {
+            head = q;
+        } else {
+            tail->next = q;
+        }
+        tail = q;
+    }
+    return head;
+}
+
+template <typename V, typename E>
+void GraphAdj<V, E>::freeList(Edge<V, E> *p) {
+    while (p != nullptr) {
+        Edge<V, E> *q = p;
+        p = p->next;
+        deleteEdge(q);
+    }
+}
+
+template <typename V, typename E>
+bool GraphAdj<V, E>::unlinkEdge(Edge<V, E> *&head, int dest) {
+    for (Edge<V, E> **link = &head; *link != nullptr; link = &(*link)->next) {
+        if ((*link)->dest == dest) {
+            Edge<V, E> *q = *link;
+            *link = q->next;
+            deleteEdge(q);
+            return true;
+        }
+    }
+    return false;
+}
+
+template <typename V, typename E>
+void GraphAdj<V, E>::redirectEdge(Edge<V, E> *head, int from, int to) {
+    for (; head != nullptr; head = head->next) {
+        if (head->dest == from) {
+            head->dest = to;
+            return;
+        }
+    }
+}
+
 template <typename V, typename E>
 size_t GraphAdj<V, E>::check_true_edges() {
     int cnt = 0;
@@ -0,0 +1,286 @@
+#ifndef GRAPH_BFS_HPP
+#define GRAPH_BFS_HPP
+
+// Multi-threaded direction-optimizing breadth-first search
+//
+// Works on any graph class offering numOfVertices() and neighbours(v)
+// ranges whose elements have .dest (GraphAdj, GraphCSR). Each level is
+// expanded either
+//   top-down:  every frontier vertex claims its unvisited out-neighbours
+//              with a CAS on parent, or
+//   bottom-up: every unvisited vertex scans its in-neighbours for one in
+//              the frontier bitmap and stops at the first hit.
+// Bottom-up wins when the frontier holds a large share of the edges, which
+// happens in the middle levels of small-world graphs. The switch follows
+// Beamer et al.: go bottom-up once the frontier's out-edges exceed
+// 1/alpha of the unexplored edges, and back to top-down once the frontier
+// shrinks below 1/beta of the vertices.
+//
+// Bottom-up steps need in-edges: the constructor builds the transpose in
+// CSR form unless the graph is declared symmetric (undirected).
+
+#include "Parallel.hpp"
+#include "Vector.hpp"
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+namespace TinySTL {
+
+struct BFSResult {
+    TinySTL::vector<int> dist;    // hops from the source, -1 if unreached
+    TinySTL::vector<int> parent;  // BFS tree, parent[source] == source
+    size_t reached;
+};
+
+template <typename GraphType>
+class ParallelBFS {
+   public:
+    explicit ParallelBFS(const GraphType &g, bool symmetric = false);
+
+    // threads == 0 uses one per core; directionOptimizing == false
+    // always expands top-down
+    BFSResult run(int source, unsigned threads = 0, bool directionOptimizing = true) const;
+
+    // the direction switching thresholds
+    int alpha;
+    int beta;
+
+   private:
+    typedef std::uint64_t Word;
+
+    struct AtomicInt {
+        std::atomic<int> value;
+        AtomicInt() : value(-1) {}
+        // vector copy-constructs its elements; only used before sharing
+        AtomicInt(const AtomicInt &x) : value(x.value.load(std::memory_order_relaxed)) {}
+    };
+
+    size_t topDownStep(const TinySTL::vector<int> &frontier, TinySTL::vector<int> &next,
+                       TinySTL::vector<AtomicInt> &parent, TinySTL::vector<int> &dist,
+                       int level, unsigned threads) const;
+    size_t bottomUpStep(const TinySTL::vector<Word> &frontier, TinySTL::vector<Word> &next,
+                        TinySTL::vector<AtomicInt> &parent, TinySTL::vector<int> &dist,
+                        int level, unsigned threads) const;
+
+    template <typename Function>
+    void forEachInNeighbour(int v, Function f) const;
+
+    static bool testBit(const TinySTL::vector<Word> &bits, int v) {
+        return (bits[v >> 6] >> (v & 63)) & 1;
+    }
+    static void setBit(TinySTL::vector<Word> &bits, int v) { bits[v >> 6] |= (Word)1 << (v & 63); }
+
+   private:
+    const GraphType &graph;
+    size_t numVertices;
+    size_t numEdges;
+    bool symmetric;
+    TinySTL::vector<size_t> outDegree;
+    TinySTL::vector<size_t> inOffsets;  // transpose in CSR form
+    TinySTL::vector<int> inSources;
+};
+
+// one-shot helper; build a ParallelBFS to run many searches on one graph
+template <typename GraphType>
+BFSResult parallelBFS(const GraphType &g, int source, unsigned threads = 0,
+                      bool symmetric = false) {
+    return ParallelBFS<GraphType>(g, symmetric).run(source, threads);
+}
+
+template <typename G>
+ParallelBFS<G>::ParallelBFS(const G &g, bool symmetric)
+    : alpha(15), beta(18), graph(g), numVertices(g.numOfVertices()), numEdges(0),
+      symmetric(symmetric) {
+    outDegree.assign(numVertices, 0);
+    if (!symmetric) {
+        inOffsets.assign(numVertices + 1, 0);
+    }
+    for (size_t v = 0; v < numVertices; v++) {
+        for (const auto &e : graph.neighbours(v)) {
+            outDegree[v]++;
+            if (!symmetric) {
+                inOffsets[e.dest + 1]++;
+            }
+        }
+        numEdges += outDegree[v];
+    }
+    if (symmetric) {
+        return;
+    }
+    for (size_t v = 0; v < numVertices; v++) {
+        inOffsets[v + 1] += inOffsets[v];
+    }
+    inSources.resize(numEdges);
+    TinySTL::vector<size_t> next(inOffsets.begin(), inOffsets.end() - 1);
+    for (size_t v = 0; v < numVertices; v++) {
+        for (const auto &e : graph.neighbours(v)) {
+            inSources[next[e.dest]++] = v;
+        }
+    }
+}
+
+template <typename G>
+template <typename Function>
+void ParallelBFS<G>::forEachInNeighbour(int v, Function f) const {
+    if (symmetric) {
+        for (const auto &e : graph.neighbours(v)) {
+            if (!f(e.dest)) {
+                return;
+            }
+        }
+    } else {
+        for (size_t i = inOffsets[v]; i < inOffsets[v + 1]; i++) {
+            if (!f(inSources[i])) {
+                return;
+            }
+        }
+    }
+}
+
+template <typename G>
+BFSResult ParallelBFS<G>::run(int source, unsigned threads, bool directionOptimizing) const {
+    assert(0 <= source && source < (int)numVertices);
+    if (threads == 0) {
+        threads = defaultThreads();
+    }
+    TinySTL::vector<AtomicInt> parent(numVertices);
+    BFSResult result;
+    result.dist.assign(numVertices, -1);
+
+    parent[source].value.store(source, std::memory_order_relaxed);
+    result.dist[source] = 0;
+    result.reached = 1;
+
+    TinySTL::vector<int> queue;  // top-down frontier
+    queue.push_back(source);
+    TinySTL::vector<Word> bitmap, nextBitmap;  // bottom-up frontier
+    size_t words = (numVertices + 63) / 64;
+
+    bool bottomUp = false;
+    size_t frontierSize = 1;
+    size_t frontierEdges = outDegree[source];
+    size_t unexploredEdges = numEdges;
+    for (int level = 0; frontierSize != 0; level++) {
+        if (directionOptimizing) {
+            if (!bottomUp && frontierEdges > unexploredEdges / alpha) {
+                // switch to bottom-up: queue -> bitmap
+                bitmap.assign(words, 0);
+                for (size_t i = 0; i < queue.size(); i++) {
+                    setBit(bitmap, queue[i]);
+                }
+                bottomUp = true;
+            } else if (bottomUp && frontierSize < numVertices / beta) {
+                // switch to top-down: bitmap -> queue
+                queue.clear();
+                for (size_t v = 0; v < numVertices; v++) {
+                    if (testBit(bitmap, v)) {
+                        queue.push_back(v);
+                    }
+                }
+                bottomUp = false;
+            }
+        }
+        unexploredEdges -= frontierEdges < unexploredEdges ? frontierEdges : unexploredEdges;
+
+        if (bottomUp) {
+            nextBitmap.assign(words, 0);
+            frontierSize = bottomUpStep(bitmap, nextBitmap, parent, result.dist, level, threads);
+            bitmap.swap(nextBitmap);
+            frontierEdges = 0;
+            for (size_t v = 0; v < numVertices; v++) {
+                if (testBit(bitmap, v)) {
+                    frontierEdges += outDegree[v];
+                }
+            }
+        } else {
+            TinySTL::vector<int> next;
+            frontierSize = topDownStep(queue, next, parent, result.dist, level, threads);
+            queue.swap(next);
+            frontierEdges = 0;
+            for (size_t i = 0; i < queue.size(); i++) {
+                frontierEdges += outDegree[queue[i]];
+            }
+        }
+        result.reached += frontierSize;
+    }
+
+    result.parent.resize(numVertices);
+    for (size_t v = 0; v < numVertices; v++) {
+        result.parent[v] = parent[v].value.load(std::memory_order_relaxed);
+    }
+    return result;
+}
+
+template <typename G>
+size_t ParallelBFS<G>::topDownStep(const TinySTL::vector<int> &frontier,
+                                   TinySTL::vector<int> &next,
+                                   TinySTL::vector<AtomicInt> &parent,
+                                   TinySTL::vector<int> &dist, int level,
+                                   unsigned threads) const {
+    // each thread collects the vertices it claimed, then they are joined
+    TinySTL::vector<TinySTL::vector<int> > local(threads);
+    parallelFor(frontier.size(), threads, [&](unsigned t, size_t begin, size_t end) {
+        TinySTL::vector<int> &out = local[t];
+        for (size_t i = begin; i < end; i++) {
+            int v = frontier[i];
+            for (const auto &e : graph.neighbours(v)) {
+                int u = e.dest;
+                int expected = -1;
+                if (parent[u].value.load(std::memory_order_relaxed) == -1 &&
+                    parent[u].value.compare_exchange_strong(expected, v,
+                                                            std::memory_order_relaxed)) {
+                    dist[u] = level + 1;
+                    out.push_back(u);
+                }
+            }
+        }
+    });
+    size_t total = 0;
+    for (unsigned t = 0; t < threads; t++) {
+        total += local[t].size();
+    }
+    next.reserve(total);
+    for (unsigned t = 0; t < threads; t++) {
+        for (size_t i = 0; i < local[t].size(); i++) {
+            next.push_back(local[t][i]);
+        }
+    }
+    return total;
+}
+
+template <typename G>
+size_t ParallelBFS<G>::bottomUpStep(const TinySTL::vector<Word> &frontier,
+                                    TinySTL::vector<Word> &next,
+                                    TinySTL::vector<AtomicInt> &parent,
+                                    TinySTL::vector<int> &dist, int level,
+                                    unsigned threads) const {
+    // chunks are whole bitmap words, so each word of next has one writer
+    std::atomic<size_t> total(0);
+    parallelFor(numVertices, threads, [&](unsigned, size_t begin, size_t end) {
+        size_t found = 0;
+        for (size_t v = begin; v < end; v++) {
+            if (parent[v].value.load(std::memory_order_relaxed) != -1) {
+                continue;
+            }
+            forEachInNeighbour(v, [&](int u) {
+                if (testBit(frontier, u)) {
+                    parent[v].value.store(u, std::memory_order_relaxed);
+                    dist[v] = level + 1;
+                    setBit(next, v);
+                    found++;
+                    return false;
+                }
+                return true;
+            });
+        }
+        total += found;
+    }, 64);
+    return total;
+}
+
+}  // namespace TinySTL
+
+#endif  // GRAPH_BFS_HPP
@@ -0,0 +1,390 @@
+#ifndef GRAPH_CSR_HPP
+#define GRAPH_CSR_HPP
+
+// Immutable graph in compressed sparse row form
+//
+// The out-edges of vertex v are targets[offsets[v] .. offsets[v + 1]) with
+// matching weights, so a traversal reads three contiguous arrays instead of
+// chasing one heap node per edge. The graph is built once, from a GraphAdj
+// (keeping each vertex's neighbour order) or from an edge list, and every
+// mutating member of the Graph interface throws std::logic_error.
+//
+// An edge list is bucketed by source with a parallel counting sort: each
+// thread counts the sources in its share of the list, a prefix sum turns
+// the counts into offsets, and each thread scatters its share into the
+// slots reserved for it, so every vertex keeps its edges in input order
+// whatever the thread count.
+
+#include "Graph.hpp"
+#include "GraphAdj.hpp"
+#include "Parallel.hpp"
+#include "Vector.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+
+namespace TinySTL {
+
+// One entry of an edge list: the edge <src, dest> with its weight
+template <typename EdgeType>
+struct WeightedEdge {
+    int src;
+    int dest;
+    EdgeType weight;
+    WeightedEdge() : src(-1), dest(-1), weight(EdgeType()) {}
+    WeightedEdge(int src, int dest, EdgeType weight = EdgeType())
+        : src(src), dest(dest), weight(weight) {}
+};
+
+template <typename VertexType, typename EdgeType = int>
+class GraphCSR : public Graph<VertexType, EdgeType> {
+   public:
+    // what iterating neighbours(v) yields
+    struct EdgeView {
+        int dest;
+        const EdgeType &weight;
+    };
+
+    class NeighbourIterator {
+       public:
+        NeighbourIterator(const int *target, const EdgeType *weight)
+            : target(target), weight(weight) {}
+        EdgeView operator*() const { return EdgeView{*target, *weight}; }
+        NeighbourIterator &operator++() {
+            ++target;
+            ++weight;
+            return *this;
+        }
+        bool operator==(const NeighbourIterator &x) const { return target == x.target; }
+        bool operator!=(const NeighbourIterator &x) const { return target != x.target; }
+
+       private:
+        const int *target;
+        const EdgeType *weight;
+    };
+
+    class NeighbourRange {
+       public:
+        NeighbourRange(const int *target, const EdgeType *weight, size_t n)
+            : target(target), weight(weight), n(n) {}
+        NeighbourIterator begin() const { return NeighbourIterator(target, weight); }
+        NeighbourIterator end() const { return NeighbourIterator(target + n, weight + n); }
+        size_t size() const { return n; }
+        bool empty() const { return n == 0; }
+
+       private:
+        const int *target;
+        const EdgeType *weight;
+        size_t n;
+    };
+
+    // neighbour order for the edge list constructor
+    enum BuildOptions {
+        KeepOrder = 0,       // as in the edge list
+        SortNeighbours = 1,  // by target, ties in edge list order
+        Deduplicate = 3      // sorted, keeping the first of repeated targets
+    };
+
+   public:
+    GraphCSR();
+    explicit GraphCSR(const GraphAdj<VertexType, EdgeType> &g);
+    // vertex i has value vertices[i]; every edge must join two of them.
+    // threads == 0 uses one per core.
+    GraphCSR(const TinySTL::vector<VertexType> &vertices,
+             const TinySTL::vector<WeightedEdge<EdgeType> > &edges, unsigned threads = 1,
+             BuildOptions options = KeepOrder);
+
+    virtual int getVertexPos(const VertexType &vertex) override;
+    virtual VertexType getValue(int v) override;
+    virtual EdgeType getWeight(int v1, int v2) override;
+    size_t getOutDegree(int v) const;
+
+    // the graph is immutable: these throw std::logic_error
+    virtual void insertVertex(const VertexType &vertex) override;
+    virtual void insertEdge(int v1, int v2, const EdgeType &weight = EdgeType()) override;
+    virtual void removeVertex(int v) override;
+    virtual void removeEdge(int v1, int v2) override;
+
+    virtual int getFirstNeighbour(int v) override;
+    virtual int getNextNeighbour(int v1, int v2) override;
+
+    virtual const void *firstEdge(int v) const override;
+    virtual const void *nextEdge(int v, const void *pos) const override;
+    virtual typename Graph<VertexType, EdgeType>::Neighbour edgeAt(int v, const void *pos) const override;
+
+    // for (auto e : g.neighbours(v)) visits e.dest / e.weight in order
+    NeighbourRange neighbours(int v) const;
+
+   protected:
+    using Graph<VertexType, EdgeType>::numVertices;
+    using Graph<VertexType, EdgeType>::numEdges;
+
+   private:
+    void buildFromEdges(const TinySTL::vector<WeightedEdge<EdgeType> > &edges, unsigned threads);
+    void sortNeighbours(unsigned threads, bool deduplicate);
+
+   private:
+    TinySTL::vector<VertexType> values;
+    TinySTL::vector<size_t> offsets;  // numVertices + 1 entries
+    TinySTL::vector<int> targets;
+    TinySTL::vector<EdgeType> weights;
+};
+
+template <typename V, typename E>
+GraphCSR<V, E>::GraphCSR() : Graph<V, E>() {
+    offsets.push_back(0);
+}
+
+template <typename V, typename E>
+GraphCSR<V, E>::GraphCSR(const GraphAdj<V, E> &g) : Graph<V, E>(g) {
+    values.resize(numVertices);
+    offsets.resize(numVertices + 1);
+    targets.resize(numEdges);
+    weights.resize(numEdges);
+    size_t pos = 0;
+    offsets[0] = 0;
+    for (size_t i = 0; i < numVertices; i++) {
+        values[i] = g.adj[i].data;
+        for (Edge<V, E> *p = g.adj[i].outEdge; p != nullptr; p = p->next) {
+            targets[pos] = p->dest;
+            weights[pos] = p->weight;
+            pos++;
+        }
+        offsets[i + 1] = pos;
+    }
+    assert(pos == numEdges);
+}
+
+template <typename V, typename E>
+GraphCSR<V, E>::GraphCSR(const TinySTL::vector<V> &vertices,
+                         const TinySTL::vector<WeightedEdge<E> > &edges, unsigned threads,
+                         BuildOptions options)
+    : Graph<V, E>(), values(vertices) {
+    numVertices = vertices.size();
+    numEdges = edges.size();
+    if (threads == 0) {
+        threads = defaultThreads();
+    }
+    buildFromEdges(edges, threads);
+    if (options != KeepOrder) {
+        sortNeighbours(threads, options == Deduplicate);
+    }
+}
+
+template <typename V, typename E>
+void GraphCSR<V, E>::buildFromEdges(const TinySTL::vector<WeightedEdge<E> > &edges,
+                                    unsigned threads) {
+    const size_t grain = 4096;
+    // count[t][v]: edges from v in thread t's share, later the slot of
+    // thread t's first such edge within v's range
+    TinySTL::vector<TinySTL::vector<size_t> > count(threads);
+    parallelFor(edges.size(), threads, [&](unsigned t, size_t begin, size_t end) {
+        count[t].assign(numVertices, 0);
+        for (size_t i = begin; i < end; i++) {
+            assert(0 <= edges[i].src && edges[i].src < (int)numVertices);
+            assert(0 <= edges[i].dest && edges[i].dest < (int)numVertices);
+            count[t][edges[i].src]++;
+        }
+    }, grain);
+
+    offsets.assign(numVertices + 1, 0);
+    parallelFor(numVertices, threads, [&](unsigned, size_t begin, size_t end) {
+        for (size_t v = begin; v < end; v++) {
+            size_t degree = 0;
+            for (unsigned t = 0; t < threads; t++) {
+                if (!count[t].empty()) {
+                    size_t c = count[t][v];
+                    count[t][v] = degree;
+                    degree += c;
+                }
+            }
+            offsets[v + 1] = degree;
+        }
+    }, grain);
+    parallelInclusiveScan(offsets.begin() + 1, numVertices, threads);
+
+    targets.resize(edges.size());
+    weights.resize(edges.size());
+    parallelFor(edges.size(), threads, [&](unsigned t, size_t begin, size_t end) {
+        TinySTL::vector<size_t> &slot = count[t];
+        for (size_t i = begin; i < end; i++) {
+            size_t pos = offsets[edges[i].src] + slot[edges[i].src]++;
+            targets[pos] = edges[i].dest;
+            weights[pos] = edges[i].weight;
+        }
+    }, grain);
+}
+
+template <typename V, typename E>
+void GraphCSR<V, E>::sortNeighbours(unsigned threads, bool deduplicate) {
+    // sort each vertex's range by target; dropping repeats leaves a gap at
+    // the end of the range, which a second pass compacts away
+    TinySTL::vector<size_t> kept(numVertices + 1, 0);
+    parallelFor(numVertices, threads, [&](unsigned, size_t begin, size_t end) {
+        TinySTL::vector<std::pair<int, E> > buffer;
+        for (size_t v = begin; v < end; v++) {
+            size_t first = offsets[v];
+            size_t last = offsets[v + 1];
+            buffer.clear();
+            for (size_t i = first; i < last; i++) {
+                buffer.push_back(std::make_pair(targets[i], weights[i]));
+            }
+            if (buffer.size() <= 32) {
+                // typical degrees: an insertion sort, also stable, without
+                // stable_sort's temporary buffer
+                for (size_t j = 1; j < buffer.size(); j++) {
+                    std::pair<int, E> x = buffer[j];
+                    size_t k = j;
+                    for (; k > 0 && x.first < buffer[k - 1].first; k--) {
+                        buffer[k] = buffer[k - 1];
+                    }
+                    buffer[k] = x;
+                }
+            } else {
+                std::stable_sort(buffer.begin(), buffer.end(),
+                                 [](const std::pair<int, E> &a, const std::pair<int, E> &b) {
+                                     return a.first < b.first;
+                                 });
+            }
+            size_t k = first;
+            for (size_t j = 0; j < buffer.size(); j++) {
+                if (deduplicate && k > first && targets[k - 1] == buffer[j].first) {
+                    continue;
+                }
+                targets[k] = buffer[j].first;
+                weights[k] = buffer[j].second;
+                k++;
+            }
+            kept[v + 1] = k - first;
+        }
+    }, 64);
+    if (!deduplicate) {
+        return;
+    }
+
+    parallelInclusiveScan(kept.begin() + 1, numVertices, threads);
+    TinySTL::vector<int> keptTargets(kept[numVertices]);
+    TinySTL::vector<E> keptWeights(kept[numVertices]);
+    parallelFor(numVertices, threads, [&](unsigned, size_t begin, size_t end) {
+        for (size_t v = begin; v < end; v++) {
+            for (size_t i = 0; i < kept[v + 1] - kept[v]; i++) {
+                keptTargets[kept[v] + i] = targets[offsets[v] + i];
+                keptWeights[kept[v] + i] = weights[offsets[v] + i];
+            }
+        }
+    }, 64);
+    offsets.swap(kept);
+    targets.swap(keptTargets);
+    weights.swap(keptWeights);
+    numEdges = offsets[numVertices];
+}
+
+template <typename V, typename E>
+int GraphCSR<V, E>::getVertexPos(const V &vertex) {
+    for (size_t i = 0; i < numVertices; i++) {
+        if (values[i] == vertex) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+template <typename V, typename E>
+V GraphCSR<V, E>::getValue(int v) {
+    assert(0 <= v && v < (int)numVertices);
+    return values[v];
+}
+
+template <typename V, typename E>
+E GraphCSR<V, E>::getWeight(int v1, int v2) {
+    assert(0 <= v1 && v1 < (int)numVertices);
+    assert(0 <= v2 && v2 < (int)numVertices);
+    for (size_t i = offsets[v1]; i < offsets[v1 + 1]; i++) {
+        if (targets[i] == v2) {
+            return weights[i];
+        }
+    }
+    assert(false && "getWeight: no edge <v1, v2>");
+    return E();
+}
+
+template <typename V, typename E>
+size_t GraphCSR<V, E>::getOutDegree(int v) const {
+    assert(0 <= v && v < (int)numVertices);
+    return offsets[v + 1] - offsets[v];
+}
+
+template <typename V, typename E>
+void GraphCSR<V, E>::insertVertex(const V &) {
+    throw std::logic_error("GraphCSR is immutable: insertVertex");
+}
+
+template <typename V, typename E>
+void GraphCSR<V, E>::insertEdge(int, int, const E &) {
+    throw std::logic_error("GraphCSR is immutable: insertEdge");
+}
+
+template <typename V, typename E>
+void GraphCSR<V, E>::removeVertex(int) {
+    throw std::logic_error("GraphCSR is immutable: removeVertex");
+}
+
+template <typename V, typename E>
+void GraphCSR<V, E>::removeEdge(int, int) {
+    throw std::logic_error("GraphCSR is immutable: removeEdge");
+}
+
+template <typename V, typename E>
+int GraphCSR<V, E>::getFirstNeighbour(int v) {
+    assert(0 <= v && v < (int)numVertices);
+    if (offsets[v] == offsets[v + 1]) {
+        return -1;
+    } else {
+        return targets[offsets[v]];
+    }
+}
+
+template <typename V, typename E>
+int GraphCSR<V, E>::getNextNeighbour(int v1, int v2) {
+    assert(0 <= v1 && v1 < (int)numVertices);
+    assert(0 <= v2 && v2 < (int)numVertices);
+    for (size_t i = offsets[v1]; i < offsets[v1 + 1]; i++) {
+        if (targets[i] == v2) {
+            return i + 1 < offsets[v1 + 1] ? targets[i + 1] : -1;
+        }
+    }
+    return -1;
+}
+
+template <typename V, typename E>
+const void *GraphCSR<V, E>::firstEdge(int v) const {
+    assert(0 <= v && v < (int)numVertices);
+    return offsets[v] == offsets[v + 1] ? nullptr : targets.begin() + offsets[v];
+}
+
+template <typename V, typename E>
+const void *GraphCSR<V, E>::nextEdge(int v, const void *pos) const {
+    const int *next = static_cast<const int *>(pos) + 1;
+    return next == targets.begin() + offsets[v + 1] ? nullptr : next;
+}
+
+template <typename V, typename E>
+typename Graph<V, E>::Neighbour GraphCSR<V, E>::edgeAt(int, const void *pos) const {
+    const int *target = static_cast<const int *>(pos);
+    return typename Graph<V, E>::Neighbour{*target, weights[target - targets.begin()]};
+}
+
+template <typename V, typename E>
+typename GraphCSR<V, E>::NeighbourRange GraphCSR<V, E>::neighbours(int v) const {
+    assert(0 <= v && v < (int)numVertices);
+    size_t first = offsets[v];
+    return NeighbourRange(targets.begin() + first, weights.begin() + first,
+                          offsets[v + 1] - first);
+}
+
+}  // namespace TinySTL
+
+#endif  // GRAPH_CSR_HPP
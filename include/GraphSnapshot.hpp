@@ -0,0 +1,377 @@
+#ifndef GRAPH_SNAPSHOT_HPP
+#define GRAPH_SNAPSHOT_HPP
+
+// Binary graph snapshots (POSIX only)
+//
+// writeGraphSnapshot stores any graph in CSR form:
+//
+//   header   128 bytes: magic, version, value/weight sizes, counts and the
+//            file offset of each section
+//   values   numVertices vertex values
+//   offsets  numVertices + 1 uint64 edge offsets
+//   targets  numEdges int32 destinations
+//   weights  numEdges edge weights
+//
+// each section starting on a 64 byte boundary. MappedGraph maps such a
+// file read-only and answers queries straight from the mapping, so
+// loading costs one mmap whatever the size of the graph, pages are read
+// on first touch and processes mapping the same snapshot share them.
+// Vertex and edge types must be trivially copyable; the file uses the
+// byte order of the machine that wrote it.
+//
+// A snapshot is written to path.tmp and renamed over path, so readers
+// still mapping the old file keep a consistent view and a crash leaves
+// the old snapshot in place.
+
+#include "Graph.hpp"
+#include "GraphCSR.hpp"
+#include "MappedFile.hpp"
+#include "Vector.hpp"
+
+#include <cassert>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+namespace TinySTL {
+
+namespace detail {
+
+struct SnapshotHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t vertexSize;
+    std::uint32_t edgeSize;
+    std::uint32_t reserved;
+    std::uint64_t numVertices;
+    std::uint64_t numEdges;
+    std::uint64_t valuesOffset;
+    std::uint64_t offsetsOffset;
+    std::uint64_t targetsOffset;
+    std::uint64_t weightsOffset;
+};
+
+static const std::size_t SnapshotHeaderSize = 128;
+static_assert(sizeof(SnapshotHeader) <= SnapshotHeaderSize, "header does not fit");
+
+inline const char *snapshotMagic() { return "TSTLGRPH"; }
+
+inline std::uint64_t snapshotAlign(std::uint64_t n) { return (n + 63) / 64 * 64; }
+
+// true if count elements of size bytes starting at offset lie within a
+// file of fileSize bytes, without overflowing
+inline bool snapshotSectionFits(std::uint64_t offset, std::uint64_t count, std::uint64_t size,
+                                std::uint64_t fileSize) {
+    return offset <= fileSize && count <= (fileSize - offset) / size;
+}
+
+// fills a mapping of the final size with header and sections
+template <typename GraphType>
+void writeSnapshotSections(GraphType &g, char *base, const SnapshotHeader &header,
+                           const TinySTL::vector<std::uint64_t> &offsets) {
+    typedef typename GraphType::vertex_type V;
+    typedef typename GraphType::edge_type E;
+    std::uint64_t n = header.numVertices;
+    std::memset(base, 0, SnapshotHeaderSize);
+    std::memcpy(base, &header, sizeof(header));
+    std::memcpy(base + header.offsetsOffset, offsets.begin(), (n + 1) * sizeof(std::uint64_t));
+    V *values = reinterpret_cast<V *>(base + header.valuesOffset);
+    std::int32_t *targets = reinterpret_cast<std::int32_t *>(base + header.targetsOffset);
+    E *weights = reinterpret_cast<E *>(base + header.weightsOffset);
+    for (std::uint64_t v = 0; v < n; v++) {
+        values[v] = g.getValue(v);
+        std::uint64_t pos = offsets[v];
+        for (const auto &e : g.neighbours(v)) {
+            targets[pos] = e.dest;
+            weights[pos] = e.weight;
+            pos++;
+        }
+        assert(pos == offsets[v + 1]);
+    }
+}
+
+}  // namespace detail
+
+// Writes g to path, replacing the file. GraphType needs numOfVertices(),
+// getValue(v), vertex_type/edge_type and neighbours(v) ranges yielding
+// .dest/.weight: GraphAdj, GraphCSR, MappedGraph or any Graph reference.
+template <typename GraphType>
+void writeGraphSnapshot(GraphType &g, const std::string &path) {
+    typedef typename GraphType::vertex_type V;
+    typedef typename GraphType::edge_type E;
+    static_assert(std::is_trivially_copyable<V>::value && std::is_trivially_copyable<E>::value,
+                  "snapshots store raw bytes of vertex values and weights");
+
+    // one pass for the offsets, so the file is sized once
+    std::uint64_t n = g.numOfVertices();
+    if (n > (std::uint64_t)INT_MAX) {
+        throw std::runtime_error("writeGraphSnapshot: too many vertices for int32 targets");
+    }
+    TinySTL::vector<std::uint64_t> offsets(n + 1, 0);
+    for (std::uint64_t v = 0; v < n; v++) {
+        std::uint64_t degree = 0;
+        for (const auto &e : g.neighbours(v)) {
+            (void)e;
+            degree++;
+        }
+        offsets[v + 1] = offsets[v] + degree;
+    }
+    std::uint64_t m = offsets[n];
+
+    detail::SnapshotHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, detail::snapshotMagic(), sizeof(header.magic));
+    header.version = 1;
+    header.vertexSize = sizeof(V);
+    header.edgeSize = sizeof(E);
+    header.numVertices = n;
+    header.numEdges = m;
+    header.valuesOffset = detail::SnapshotHeaderSize;
+    header.offsetsOffset = detail::snapshotAlign(header.valuesOffset + n * sizeof(V));
+    header.targetsOffset = detail::snapshotAlign(header.offsetsOffset + (n + 1) * sizeof(std::uint64_t));
+    header.weightsOffset = detail::snapshotAlign(header.targetsOffset + m * sizeof(std::int32_t));
+    std::uint64_t total = header.weightsOffset + m * sizeof(E);
+
+    std::string tmpPath = path + ".tmp";
+    try {
+        mapped_file file(tmpPath, mapped_file::read_write, true);
+        file.resize(0);  // drop whatever a failed writer left behind
+        file.resize(total);
+        detail::writeSnapshotSections(g, file.data(), header, offsets);
+        file.flush();
+    } catch (...) {
+        std::remove(tmpPath.c_str());
+        throw;
+    }
+    if (std::rename(tmpPath.c_str(), path.c_str()) != 0) {
+        std::remove(tmpPath.c_str());
+        throw std::runtime_error("writeGraphSnapshot: cannot rename " + tmpPath + " to " + path);
+    }
+}
+
+// Read-only graph served from a snapshot file. Mutators throw
+// std::logic_error, like GraphCSR's.
+//
+// Opening checks the header, the section bounds and their alignment in
+// O(1). With verify (the default) it also checks that the offsets are
+// monotonic and every target is a vertex, which reads the offsets and
+// targets once; pass verify = false only for files from a trusted writer,
+// as a corrupt one then leads to out-of-bounds reads.
+template <typename VertexType, typename EdgeType = int>
+class MappedGraph : public Graph<VertexType, EdgeType> {
+    static_assert(std::is_trivially_copyable<VertexType>::value &&
+                      std::is_trivially_copyable<EdgeType>::value,
+                  "snapshots store raw bytes of vertex values and weights");
+
+   public:
+    typedef typename GraphCSR<VertexType, EdgeType>::EdgeView EdgeView;
+    typedef typename GraphCSR<VertexType, EdgeType>::NeighbourIterator NeighbourIterator;
+    typedef typename GraphCSR<VertexType, EdgeType>::NeighbourRange NeighbourRange;
+
+   public:
+    // throws std::runtime_error if path is not a valid snapshot of this type
+    explicit MappedGraph(const std::string &path, bool verify = true);
+    MappedGraph(const MappedGraph &) = delete;
+    MappedGraph &operator=(const MappedGraph &) = delete;
+
+    virtual int getVertexPos(const VertexType &vertex) override;
+    virtual VertexType getValue(int v) override;
+    virtual EdgeType getWeight(int v1, int v2) override;
+    size_t getOutDegree(int v) const;
+
+    // the graph is immutable: these throw std::logic_error
+    virtual void insertVertex(const VertexType &vertex) override;
+    virtual void insertEdge(int v1, int v2, const EdgeType &weight = EdgeType()) override;
+    virtual void removeVertex(int v) override;
+    virtual void removeEdge(int v1, int v2) override;
+
+    virtual int getFirstNeighbour(int v) override;
+    virtual int getNextNeighbour(int v1, int v2) override;
+
+    virtual const void *firstEdge(int v) const override;
+    virtual const void *nextEdge(int v, const void *pos) const override;
+    virtual typename Graph<VertexType, EdgeType>::Neighbour edgeAt(int v, const void *pos) const override;
+
+    // for (auto e : g.neighbours(v)) visits e.dest / e.weight in order
+    NeighbourRange neighbours(int v) const;
+
+   protected:
+    using Graph<VertexType, EdgeType>::numVertices;
+    using Graph<VertexType, EdgeType>::numEdges;
+
+   private:
+    mapped_file file;
+    const VertexType *values;
+    const std::uint64_t *offsets;  // numVertices + 1 entries
+    const int *targets;
+    const EdgeType *weights;
+};
+
+template <typename V, typename E>
+MappedGraph<V, E>::MappedGraph(const std::string &path, bool verify)
+    : Graph<V, E>(), file(path, mapped_file::read_only) {
+    static_assert(sizeof(int) == sizeof(std::int32_t), "targets are stored as int32");
+    detail::SnapshotHeader header;
+    if (file.size() < detail::SnapshotHeaderSize) {
+        throw std::runtime_error("MappedGraph: " + path + " is not a graph snapshot");
+    }
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (std::memcmp(header.magic, detail::snapshotMagic(), sizeof(header.magic)) != 0 ||
+        header.version != 1) {
+        throw std::runtime_error("MappedGraph: " + path + " is not a graph snapshot");
+    }
+    if (header.vertexSize != sizeof(V) || header.edgeSize != sizeof(E)) {
+        throw std::runtime_error("MappedGraph: value or weight size mismatch in " + path);
+    }
+    std::uint64_t n = header.numVertices;
+    std::uint64_t m = header.numEdges;
+    std::uint64_t size = file.size();
+    if (n > (std::uint64_t)INT_MAX) {
+        throw std::runtime_error("MappedGraph: " + path + " has too many vertices");
+    }
+    // the mapping is page aligned, so aligned offsets give aligned sections
+    if (header.valuesOffset < detail::SnapshotHeaderSize || header.valuesOffset % 64 != 0 ||
+        header.offsetsOffset % 64 != 0 || header.targetsOffset % 64 != 0 ||
+        header.weightsOffset % 64 != 0) {
+        throw std::runtime_error("MappedGraph: misaligned section in " + path);
+    }
+    if (!detail::snapshotSectionFits(header.valuesOffset, n, sizeof(V), size) ||
+        !detail::snapshotSectionFits(header.offsetsOffset, n + 1, sizeof(std::uint64_t), size) ||
+        !detail::snapshotSectionFits(header.targetsOffset, m, sizeof(std::int32_t), size) ||
+        !detail::snapshotSectionFits(header.weightsOffset, m, sizeof(E), size)) {
+        throw std::runtime_error("MappedGraph: " + path + " is truncated");
+    }
+    const char *base = file.data();
+    values = reinterpret_cast<const V *>(base + header.valuesOffset);
+    offsets = reinterpret_cast<const std::uint64_t *>(base + header.offsetsOffset);
+    targets = reinterpret_cast<const int *>(base + header.targetsOffset);
+    weights = reinterpret_cast<const E *>(base + header.weightsOffset);
+    if (offsets[0] != 0 || offsets[n] != m) {
+        throw std::runtime_error("MappedGraph: " + path + " has inconsistent offsets");
+    }
+    if (verify) {
+        for (std::uint64_t v = 0; v < n; v++) {
+            if (offsets[v] > offsets[v + 1]) {
+                throw std::runtime_error("MappedGraph: " + path + " has inconsistent offsets");
+            }
+        }
+        for (std::uint64_t i = 0; i < m; i++) {
+            if (targets[i] < 0 || (std::uint64_t)targets[i] >= n) {
+                throw std::runtime_error("MappedGraph: " + path + " has an edge to no vertex");
+            }
+        }
+    }
+    numVertices = n;
+    numEdges = m;
+}
+
+template <typename V, typename E>
+int MappedGraph<V, E>::getVertexPos(const V &vertex) {
+    for (size_t i = 0; i < numVertices; i++) {
+        if (values[i] == vertex) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+template <typename V, typename E>
+V MappedGraph<V, E>::getValue(int v) {
+    assert(0 <= v && v < (int)numVertices);
+    return values[v];
+}
+
+template <typename V, typename E>
+E MappedGraph<V, E>::getWeight(int v1, int v2) {
+    assert(0 <= v1 && v1 < (int)numVertices);
+    assert(0 <= v2 && v2 < (int)numVertices);
+    for (std::uint64_t i = offsets[v1]; i < offsets[v1 + 1]; i++) {
+        if (targets[i] == v2) {
+            return weights[i];
+        }
+    }
+    assert(false && "getWeight: no edge <v1, v2>");
+    return E();
+}
+
+template <typename V, typename E>
+size_t MappedGraph<V, E>::getOutDegree(int v) const {
+    assert(0 <= v && v < (int)numVertices);
+    return offsets[v + 1] - offsets[v];
+}
+
+template <typename V, typename E>
+void MappedGraph<V, E>::insertVertex(const V &) {
+    throw std::logic_error("MappedGraph is immutable: insertVertex");
+}
+
+template <typename V, typename E>
+void MappedGraph<V, E>::insertEdge(int, int, const E &) {
+    throw std::logic_error("MappedGraph is immutable: insertEdge");
+}
+
+template <typename V, typename E>
+void MappedGraph<V, E>::removeVertex(int) {
+    throw std::logic_error("MappedGraph is immutable: removeVertex");
+}
+
+template <typename V, typename E>
+void MappedGraph<V, E>::removeEdge(int, int) {
+    throw std::logic_error("MappedGraph is immutable: removeEdge");
+}
+
+template <typename V, typename E>
+int MappedGraph<V, E>::getFirstNeighbour(int v) {
+    assert(0 <= v && v < (int)numVertices);
+    if (offsets[v] == offsets[v + 1]) {
+        return -1;
+    } else {
+        return targets[offsets[v]];
+    }
+}
+
+template <typename V, typename E>
+int MappedGraph<V, E>::getNextNeighbour(int v1, int v2) {
+    assert(0 <= v1 && v1 < (int)numVertices);
+    assert(0 <= v2 && v2 < (int)numVertices);
+    for (std::uint64_t i = offsets[v1]; i < offsets[v1 + 1]; i++) {
+        if (targets[i] == v2) {
+            return i + 1 < offsets[v1 + 1] ? targets[i + 1] : -1;
+        }
+    }
+    return -1;
+}
+
+template <typename V, typename E>
+const void *MappedGraph<V, E>::firstEdge(int v) const {
+    assert(0 <= v && v < (int)numVertices);
+    return offsets[v] == offsets[v + 1] ? nullptr : targets + offsets[v];
+}
+
+template <typename V, typename E>
+const void *MappedGraph<V, E>::nextEdge(int v, const void *pos) const {
+    const int *next = static_cast<const int *>(pos) + 1;
+    return next == targets + offsets[v + 1] ? nullptr : next;
+}
+
+template <typename V, typename E>
+typename Graph<V, E>::Neighbour MappedGraph<V, E>::edgeAt(int, const void *pos) const {
+    const int *target = static_cast<const int *>(pos);
+    return typename Graph<V, E>::Neighbour{*target, weights[target - targets]};
+}
+
+template <typename V, typename E>
+typename MappedGraph<V, E>::NeighbourRange MappedGraph<V, E>::neighbours(int v) const {
+    assert(0 <= v && v < (int)numVertices);
+    std::uint64_t first = offsets[v];
+    return NeighbourRange(targets + first, weights + first, offsets[v + 1] - first);
+}
+
+}  // namespace TinySTL
+
+#endif  // GRAPH_SNAPSHOT_HPP
@@ -1,6 +1,7 @@
 #ifndef ITERATOR_HPP
 #define ITERATOR_HPP
 
+#include <cstddef>
 #include "type_traits.hpp"
 
 namespace TinySTL {
@@ -0,0 +1,158 @@
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+// RAII wrapper around a file mapped with MAP_SHARED (POSIX only)
+//
+// The whole file is mapped; resize() changes the file length and remaps it
+// (with mremap on Linux), so pointers into the mapping are invalidated by
+// resize(). Read-only mappings of the same file share page cache pages
+// across processes.
+
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace TinySTL {
+
+    class mapped_file {
+    public:
+        enum mode { read_only, read_write };
+
+    public:
+        mapped_file() : fd(-1), addr(nullptr), length(0), fileMode(read_only) { }
+
+        mapped_file(const std::string& path, mode m, bool create = false)
+            : mapped_file() {
+            open(path, m, create);
+        }
+
+        mapped_file(const mapped_file&) = delete;
+        mapped_file& operator=(const mapped_file&) = delete;
+
+        mapped_file(mapped_file&& rhs) noexcept
+            : fd(rhs.fd), addr(rhs.addr), length(rhs.length), fileMode(rhs.fileMode) {
+            rhs.fd = -1;
+            rhs.addr = nullptr;
+            rhs.length = 0;
+        }
+
+        mapped_file& operator=(mapped_file&& rhs) noexcept {
+            if (this != &rhs) {
+                close();
+                std::swap(fd, rhs.fd);
+                std::swap(addr, rhs.addr);
+                std::swap(length, rhs.length);
+                std::swap(fileMode, rhs.fileMode);
+            }
+            return *this;
+        }
+
+        ~mapped_file() { close(); }
+
+        // open path and map all of it; create makes a missing file (empty)
+        void open(const std::string& path, mode m, bool create = false) {
+            close();
+            int flags = (m == read_write ? O_RDWR : O_RDONLY) | (create ? O_CREAT : 0);
+            fd = ::open(path.c_str(), flags, 0644);
+            if (fd < 0) {
+                fail("open " + path);
+            }
+            struct stat st;
+            if (::fstat(fd, &st) != 0) {
+                fail("fstat " + path);
+            }
+            fileMode = m;
+            length   = (std::size_t)st.st_size;
+            map();
+        }
+
+        void close() {
+            unmap();
+            if (fd >= 0) {
+                ::close(fd);
+                fd = -1;
+            }
+            length = 0;
+        }
+
+        // change the file length to bytes and remap; needs read_write
+        void resize(std::size_t bytes) {
+            if (fileMode != read_write) {
+                throw std::runtime_error("mapped_file: resize of a read-only mapping");
+            }
+            if (::ftruncate(fd, (off_t)bytes) != 0) {
+                fail("ftruncate");
+            }
+#if defined(__linux__)
+            if (addr != nullptr && bytes > 0) {
+                void* p = ::mremap(addr, length, bytes, MREMAP_MAYMOVE);
+                if (p == MAP_FAILED) {
+                    fail("mremap");
+                }
+                addr   = static_cast<char*>(p);
+                length = bytes;
+                return;
+            }
+#endif
+            unmap();
+            length = bytes;
+            map();
+        }
+
+        // write dirty pages back to the file
+        void flush(bool async = false) {
+            if (addr != nullptr && ::msync(addr, length, async ? MS_ASYNC : MS_SYNC) != 0) {
+                fail("msync");
+            }
+        }
+
+        bool is_open() const { return fd >= 0; }
+        bool writable() const { return fileMode == read_write; }
+
+              char* data()       { return addr; }
+        const char* data() const { return addr; }
+        std::size_t size() const { return length; }
+
+    private:
+        void map() {
+            if (length == 0) {
+                addr = nullptr;
+                return;
+            }
+            int prot = PROT_READ | (fileMode == read_write ? PROT_WRITE : 0);
+            void* p = ::mmap(nullptr, length, prot, MAP_SHARED, fd, 0);
+            if (p == MAP_FAILED) {
+                fail("mmap");
+            }
+            addr = static_cast<char*>(p);
+        }
+
+        void unmap() {
+            if (addr != nullptr) {
+                ::munmap(addr, length);
+                addr = nullptr;
+            }
+        }
+
+        static void fail(const std::string& what) {
+            throw std::runtime_error("mapped_file: " + what + ": " + std::strerror(errno));
+        }
+
+    private:
+        int fd;
+        char* addr;
+        std::size_t length;
+        mode fileMode;
+    };
+
+}  // namespace TinySTL
+
+#endif  // MAPPED_FILE_HPP
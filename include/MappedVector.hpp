@@ -0,0 +1,270 @@
+#ifndef MAPPED_VECTOR_HPP
+#define MAPPED_VECTOR_HPP
+
+// vector whose storage is a memory-mapped file
+//
+// mapped_vector<T> offers the accessor surface of TinySTL::vector over a
+// file of fixed-size records, so opening a multi-GB dataset costs one mmap
+// and pages are shared between processes mapping the same file. The file
+// starts with a 64 byte header (magic, record size, element count) followed
+// by the raw records; the count lives in the mapping itself, so other
+// processes see records as they are appended, up to the length of the
+// file when they mapped it (reopen to see further). Appends grow the file geometrically
+// and the spare tail is kept until shrink_to_fit() trims it explicitly;
+// that must not happen while other processes still map the tail, which
+// would fault on access. T must be trivially copyable.
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include "MappedFile.hpp"
+
+namespace TinySTL {
+
+    template <typename T>
+    class mapped_vector {
+       public:
+        using value_type      = T;
+        using reference       = value_type&;
+        using const_reference = const value_type&;
+        using pointer         = value_type*;
+        using const_pointer   = const value_type*;
+        using iterator        = value_type*;
+        using const_iterator  = const value_type*;
+        using difference_type = std::ptrdiff_t;
+        using size_type       = std::size_t;
+        using mode            = mapped_file::mode;
+
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "mapped_vector stores raw bytes of trivially copyable records");
+
+       public:
+        mapped_vector() { }
+
+        // open (or with read_write, create) the dataset at path
+        explicit mapped_vector(const std::string& path, mode m = mapped_file::read_write) {
+            open(path, m);
+        }
+
+        mapped_vector(mapped_vector&&) = default;
+        mapped_vector& operator=(mapped_vector&&) = default;
+
+        ~mapped_vector() { close(); }
+
+        void open(const std::string& path, mode m = mapped_file::read_write);
+        // unmaps without trimming: call shrink_to_fit() first if wanted
+        void close() noexcept { file.close(); }
+        bool is_open() const { return file.is_open(); }
+
+        // Iterators:
+              iterator begin() noexcept       { return data(); }
+        const_iterator begin() const noexcept { return data(); }
+              iterator end()   noexcept       { return data() + size(); }
+        const_iterator end()   const noexcept { return data() + size(); }
+        const_iterator cbegin() const noexcept { return data(); }
+        const_iterator cend()   const noexcept { return data() + size(); }
+
+        // Capacity
+        // another writer may have appended past this process's mapping
+        size_type size() const noexcept {
+            if (!is_open()) {
+                return 0;
+            }
+            std::uint64_t count = header()->count;
+            return count < capacity() ? (size_type)count : capacity();
+        }
+        size_type capacity() const noexcept {
+            return is_open() ? (file.size() - HeaderSize) / sizeof(T) : 0;
+        }
+        bool empty() const noexcept { return size() == 0; }
+        void reserve(size_type n);
+        void resize(size_type n, const value_type& val = value_type());
+        void shrink_to_fit();
+
+        // Element access:
+              reference operator[] (size_type n)        { return data()[n]; }
+        const_reference operator[] (size_type n) const  { return data()[n]; }
+              reference at (size_type n);
+        const_reference at (size_type n) const;
+              reference front()         { return data()[0]; }
+        const_reference front() const   { return data()[0]; }
+              reference back()          { return data()[size() - 1]; }
+        const_reference back() const    { return data()[size() - 1]; }
+              pointer   data() noexcept       { return is_open() ? reinterpret_cast<T*>(file.data() + HeaderSize) : nullptr; }
+        const_pointer   data() const noexcept { return is_open() ? reinterpret_cast<const T*>(file.data() + HeaderSize) : nullptr; }
+
+        // Modifiers
+        void push_back(const value_type& val);
+        template <typename InputIterator>
+        void append(InputIterator first, InputIterator last);
+        void pop_back();
+        void clear();
+
+        // write dirty records and the header back to the file
+        void flush(bool async = false) { file.flush(async); }
+
+       private:
+        struct Header {
+            char          magic[8];
+            std::uint32_t version;
+            std::uint32_t recordSize;
+            std::uint64_t count;
+        };
+        static const size_type HeaderSize = 64;
+        static_assert(sizeof(Header) <= HeaderSize, "header does not fit");
+
+              Header* header()       { return reinterpret_cast<Header*>(file.data()); }
+        const Header* header() const { return reinterpret_cast<const Header*>(file.data()); }
+
+        void checkWritable() const;
+        void overflowHandle(size_type minSize);
+
+       private:
+        mapped_file file;
+    };
+
+}  // namespace TinySTL
+
+
+namespace TinySTL {
+
+    template <typename T>
+    void mapped_vector<T>::open(const std::string& path, mode m) {
+        static const char magic[8] = { 'T', 'S', 'T', 'L', 'M', 'V', 'E', 'C' };
+        file.open(path, m, m == mapped_file::read_write);
+        if (file.size() == 0 && m == mapped_file::read_write) {
+            // fresh file: write the header
+            file.resize(HeaderSize);
+            std::memset(file.data(), 0, HeaderSize);
+            std::memcpy(header()->magic, magic, sizeof(magic));
+            header()->version    = 1;
+            header()->recordSize = sizeof(T);
+            header()->count      = 0;
+        }
+        if (file.size() < HeaderSize || std::memcmp(header()->magic, magic, sizeof(magic)) != 0) {
+            file.close();
+            throw std::runtime_error("mapped_vector: " + path + " is not a mapped_vector file");
+        }
+        if (header()->recordSize != sizeof(T)) {
+            file.close();
+            throw std::runtime_error("mapped_vector: record size mismatch in " + path);
+        }
+        if (header()->count > (file.size() - HeaderSize) / sizeof(T)) {
+            file.close();
+            throw std::runtime_error("mapped_vector: " + path + " is truncated");
+        }
+    }
+
+    template <typename T>
+    void mapped_vector<T>::reserve(size_type n) {
+        checkWritable();
+        if (n > capacity()) {
+            file.resize(HeaderSize + n * sizeof(T));
+        }
+    }
+
+    template <typename T>
+    void mapped_vector<T>::resize(size_type n, const value_type& val) {
+        checkWritable();
+        size_type currentSize = size();
+        if (n > currentSize) {
+            value_type tmp(val);
+            reserve(n);
+            for (T* p = data() + currentSize; p != data() + n; ++p) {
+                *p = tmp;
+            }
+        }
+        header()->count = n;
+    }
+
+    template <typename T>
+    void mapped_vector<T>::shrink_to_fit() {
+        checkWritable();
+        if (capacity() > size()) {
+            file.resize(HeaderSize + size() * sizeof(T));
+        }
+    }
+
+    template <typename T>
+    typename mapped_vector<T>::reference mapped_vector<T>::at(size_type n) {
+        if (n >= size()) {
+            throw std::out_of_range("index is out of range");
+        }
+        return data()[n];
+    }
+
+    template <typename T>
+    typename mapped_vector<T>::const_reference mapped_vector<T>::at(size_type n) const {
+        if (n >= size()) {
+            throw std::out_of_range("index is out of range");
+        }
+        return data()[n];
+    }
+
+    template <typename T>
+    void mapped_vector<T>::push_back(const value_type& val) {
+        checkWritable();
+        size_type currentSize = size();
+        if (currentSize == capacity()) {
+            // val may point into the mapping that is about to move
+            value_type tmp(val);
+            overflowHandle(currentSize + 1);
+            data()[currentSize] = tmp;
+        } else {
+            data()[currentSize] = val;
+        }
+        header()->count = currentSize + 1;
+    }
+
+    template <typename T>
+    template <typename InputIterator>
+    void mapped_vector<T>::append(InputIterator first, InputIterator last) {
+        checkWritable();
+        size_type currentSize = size();
+        size_type n = last - first;
+        if (currentSize + n > capacity()) {
+            overflowHandle(currentSize + n);
+        }
+        T* p = data() + currentSize;
+        for (; first != last; ++first, ++p) {
+            *p = *first;
+        }
+        header()->count = currentSize + n;
+    }
+
+    template <typename T>
+    void mapped_vector<T>::pop_back() {
+        checkWritable();
+        if (size() > 0) {
+            header()->count--;
+        }
+    }
+
+    template <typename T>
+    void mapped_vector<T>::clear() {
+        checkWritable();
+        header()->count = 0;
+    }
+
+    template <typename T>
+    void mapped_vector<T>::checkWritable() const {
+        if (!is_open() || !file.writable()) {
+            throw std::runtime_error("mapped_vector: not opened for writing");
+        }
+    }
+
+    template <typename T>
+    void mapped_vector<T>::overflowHandle(size_type minSize) {
+        size_type allocSize = 2 * capacity();
+        if (allocSize < minSize) {
+            allocSize = minSize;
+        }
+        reserve(allocSize);
+    }
+
+}  // namespace TinySTL
+
+#endif  // MAPPED_VECTOR_HPP
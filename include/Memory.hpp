@@ -2,9 +2,13 @@
 #define MEMORY_HPP
 
 #include <cstdlib>
+#include <cstring>
 #include <limits>
+#include <new>
 #include <type_traits>
+#include <utility>
 #include "Iterator.hpp"
+#include "type_traits.hpp"
 
 namespace TinySTL {
 
@@ -28,6 +32,7 @@ namespace TinySTL {
         // nothing to do because the allocator has no state
         allocator() noexcept { }
         allocator(const allocator& alloc) noexcept { }
+        allocator& operator=(const allocator&) noexcept { return *this; }
         template <typename U>
         allocator(const allocator<U>& alloc) noexcept { }
         ~allocator() { }
@@ -39,7 +44,7 @@ namespace TinySTL {
             return std::numeric_limits<std::size_t>::max() / sizeof(value_type);
         }
 
-        pointer allocate(size_type num, allocator<void>::const_pointer hint = 0) {
+        pointer allocate(size_type num, const void* = 0) {
         //return static_cast<pointer>(malloc(sizeof(T) * n));
             pointer ret = static_cast<pointer>(::operator new(num * sizeof(T)));
             return ret;
@@ -48,7 +53,7 @@ namespace TinySTL {
         template <typename U, typename... Args>
         void construct(U* p, Args&&... args) {
             // placement new
-            new (static_cast<void*>(p))T(std::forward<Args>(args)...)
+            new (static_cast<void*>(p))T(std::forward<Args>(args)...);
         }
 
         void deallocate(pointer p, size_type n) {
@@ -61,6 +66,13 @@ namespace TinySTL {
         }
     };
 
+    // stateless: memory from any allocator can be freed by any other
+    template <typename T, typename U>
+    bool operator==(const allocator<T>&, const allocator<U>&) noexcept { return true; }
+
+    template <typename T, typename U>
+    bool operator!=(const allocator<T>&, const allocator<U>&) noexcept { return false; }
+
     template <> class allocator<void> {
     public:
         typedef void* pointer;
@@ -69,9 +81,41 @@ namespace TinySTL {
         template <typename U> struct rebind { typedef allocator<U> other; };
     };
 
+    // allocator_has_reallocate<Alloc>::value is true when Alloc provides
+    //   pointer reallocate(pointer p, size_type oldNum, size_type newNum,
+    //                      size_type* bytesCopied)
+    // that resizes a buffer of trivially relocatable elements in place of
+    // allocate + memcpy + deallocate (see MmapAllocator.hpp), storing the
+    // number of bytes it actually copied (0 when remapped) in *bytesCopied
+    template <typename Alloc, typename = void>
+    struct allocator_has_reallocate : std::false_type {};
+
+    template <typename Alloc>
+    struct allocator_has_reallocate<Alloc, void_t<decltype(std::declval<Alloc&>().reallocate(
+        std::declval<typename Alloc::pointer>(), std::size_t(), std::size_t(),
+        std::declval<std::size_t*>()))>>
+        : std::true_type {};
+
+    // uninitialized_copy / uninitialized_fill family
+    //
+    // When both ends are raw pointers to the same trivially copyable type the
+    // element-wise placement new is equivalent to a byte copy, so these
+    // overloads are tag dispatched to memmove/memset (or a plain assignment
+    // loop the compiler turns into one). Everything else keeps the generic
+    // placement-new loop.
+
+    template <typename InputIterator, typename ForwardIterator>
+    struct is_bitwise_copyable : std::false_type {};
+
+    template <typename T, typename U>
+    struct is_bitwise_copyable<T*, U*>
+        : std::integral_constant<bool,
+              std::is_same<typename std::remove_const<T>::type, U>::value &&
+              std::is_trivially_copyable<U>::value> {};
+
     template<typename InputIterator, typename ForwardIterator>
-    ForwardIterator uninitialized_copy(InputIterator first, InputIterator last,
-        ForwardIterator result)
+    ForwardIterator uninitialized_copy_aux(InputIterator first, InputIterator last,
+        ForwardIterator result, std::false_type)
     {
         for (; first != last; ++result, ++first)
             new (static_cast<void*>(&*result))
@@ -79,8 +123,26 @@ namespace TinySTL {
         return result;
     }
 
+    template<typename T, typename U>
+    U* uninitialized_copy_aux(T* first, T* last, U* result, std::true_type)
+    {
+        std::size_t n = last - first;
+        if (n > 0)
+            std::memmove(static_cast<void*>(result), static_cast<const void*>(first), n * sizeof(U));
+        return result + n;
+    }
+
+    template<typename InputIterator, typename ForwardIterator>
+    ForwardIterator uninitialized_copy(InputIterator first, InputIterator last,
+        ForwardIterator result)
+    {
+        return uninitialized_copy_aux(first, last, result,
+            is_bitwise_copyable<InputIterator, ForwardIterator>());
+    }
+
     template<typename InputIterator, typename Size, typename ForwardIterator>
-    ForwardIterator uninitialized_copy_n(InputIterator first, Size n, ForwardIterator result)
+    ForwardIterator uninitialized_copy_n_aux(InputIterator first, Size n,
+        ForwardIterator result, std::false_type)
     {
         for (; n > 0; ++result, ++first, --n)
             new (static_cast<void*>(&*result))
@@ -88,23 +150,137 @@ namespace TinySTL {
         return result;
     }
 
+    template<typename T, typename Size, typename U>
+    U* uninitialized_copy_n_aux(T* first, Size n, U* result, std::true_type)
+    {
+        if (n <= 0)
+            return result;
+        std::memmove(static_cast<void*>(result), static_cast<const void*>(first), n * sizeof(U));
+        return result + n;
+    }
+
+    template<typename InputIterator, typename Size, typename ForwardIterator>
+    ForwardIterator uninitialized_copy_n(InputIterator first, Size n, ForwardIterator result)
+    {
+        return uninitialized_copy_n_aux(first, n, result,
+            is_bitwise_copyable<InputIterator, ForwardIterator>());
+    }
+
+    // fill: single byte payloads go straight to memset, wider trivially
+    // copyable payloads are memcpy'd into the raw storage one element at a
+    // time, which the optimizer turns into a memset/vector store loop. The
+    // copy is bytewise rather than an assignment so that types whose copy
+    // assignment is deleted (const members) still take this path.
+    template <typename ForwardIterator, typename T>
+    struct is_bitwise_fillable : std::false_type {};
+
+    template <typename U, typename T>
+    struct is_bitwise_fillable<U*, T>
+        : std::integral_constant<bool,
+              std::is_trivially_copyable<U>::value &&
+              std::is_convertible<const T&, U>::value> {};
+
+    template <typename U>
+    void fill_bytes(U* first, std::size_t n, const U& x, std::true_type)
+    {
+        unsigned char byte;
+        std::memcpy(&byte, &x, 1);
+        std::memset(static_cast<void*>(first), byte, n);
+    }
+
+    template <typename U>
+    void fill_bytes(U* first, std::size_t n, const U& x, std::false_type)
+    {
+        for (U* last = first + n; first != last; ++first)
+            std::memcpy(static_cast<void*>(first), static_cast<const void*>(&x), sizeof(U));
+    }
+
     template < typename ForwardIterator, typename T >
-    void uninitialized_fill(ForwardIterator first, ForwardIterator last, const T& x)
+    void uninitialized_fill_aux(ForwardIterator first, ForwardIterator last, const T& x,
+        std::false_type)
     {
         for (; first != last; ++first)
             new (static_cast<void*>(&*first))
             typename TinySTL::Iterator::iterator_traits<ForwardIterator>::value_type(x);
     }
 
+    template < typename U, typename T >
+    void uninitialized_fill_aux(U* first, U* last, const T& x, std::true_type)
+    {
+        const U val = x;
+        fill_bytes(first, last - first, val, std::integral_constant<bool, sizeof(U) == 1>());
+    }
+
+    template < typename ForwardIterator, typename T >
+    void uninitialized_fill(ForwardIterator first, ForwardIterator last, const T& x)
+    {
+        uninitialized_fill_aux(first, last, x, is_bitwise_fillable<ForwardIterator, T>());
+    }
+
     template < typename ForwardIterator, typename Size, typename T >
-    ForwardIterator uninitialized_fill_n(ForwardIterator first, Size n, const T& x)
+    ForwardIterator uninitialized_fill_n_aux(ForwardIterator first, Size n, const T& x,
+        std::false_type)
     {
-        for (; n--; ++first)
+        for (; n > 0; ++first, --n)
             new (static_cast<void*>(&*first))
             typename TinySTL::Iterator::iterator_traits<ForwardIterator>::value_type(x);
         return first;
     }
 
+    template < typename U, typename Size, typename T >
+    U* uninitialized_fill_n_aux(U* first, Size n, const T& x, std::true_type)
+    {
+        if (n <= 0)
+            return first;
+        const U val = x;
+        fill_bytes(first, n, val, std::integral_constant<bool, sizeof(U) == 1>());
+        return first + n;
+    }
+
+    template < typename ForwardIterator, typename Size, typename T >
+    ForwardIterator uninitialized_fill_n(ForwardIterator first, Size n, const T& x)
+    {
+        return uninitialized_fill_n_aux(first, n, x, is_bitwise_fillable<ForwardIterator, T>());
+    }
+
+    // uninitialized_relocate_n
+    //
+    // Moves n objects from [first, first + n) into the raw storage at result
+    // and ends the lifetime of the originals. Trivially relocatable types are
+    // memcpy'd; everything else is constructed with move_if_noexcept, so a
+    // throwing copy leaves the source untouched (strong guarantee).
+    template <typename T, typename Size>
+    T* uninitialized_relocate_n_aux(T* first, Size n, T* result, std::true_type)
+    {
+        if (n <= 0)
+            return result;
+        std::memcpy(static_cast<void*>(result), static_cast<const void*>(first), n * sizeof(T));
+        return result + n;
+    }
+
+    template <typename T, typename Size>
+    T* uninitialized_relocate_n_aux(T* first, Size n, T* result, std::false_type)
+    {
+        T* cur = result;
+        try {
+            for (Size i = 0; i < n; ++i, ++cur)
+                new (static_cast<void*>(cur)) T(std::move_if_noexcept(first[i]));
+        } catch (...) {
+            for (T* p = result; p != cur; ++p)
+                p->~T();
+            throw;
+        }
+        for (Size i = 0; i < n; ++i)
+            first[i].~T();
+        return cur;
+    }
+
+    template <typename T, typename Size>
+    T* uninitialized_relocate_n(T* first, Size n, T* result)
+    {
+        return uninitialized_relocate_n_aux(first, n, result,
+            std::integral_constant<bool, TinySTL::is_trivially_relocatable<T>::value>());
+    }
 
 }  // namespace TinySTL
 
@@ -4,6 +4,7 @@
 #include <cstdlib>
 #include <iostream>
 #include <cassert>
+#include <utility>
 #include "Memory.hpp"
 
 namespace TinySTL {
@@ -111,36 +112,45 @@ namespace TinySTL {
         return *this;
     }
 
+    // Bottom-up: the hole left at start sinks to a leaf along the smaller
+    // children, then the displaced value climbs back to where it belongs.
+    // Values sifted down come from the bottom of the heap, so the climb is
+    // short and about half the comparisons of a swap-per-level sift are
+    // saved.
     template <typename T>
     void MinHeap<T>::siftDown(int start, int end) {
+        T val = std::move(heap[start]);
         int p = start;
-        while (p < end) {
-            int k = 2 * p + 1;
-            if (k > currentSize)
-                break;
-            if (k + 1 < currentSize && heap[k] > heap[k + 1])
+        int k = 2 * p + 1;
+        while (k <= end) {
+            if (k < end && heap[k + 1] < heap[k])
                 k++;
-            if (heap[p] < heap[k])
+            heap[p] = std::move(heap[k]);
+            p = k;
+            k = 2 * p + 1;
+        }
+        while (p > start) {
+            k = (p - 1) / 2;
+            if (!(val < heap[k]))
                 break;
-            T temp = heap[k];
-            heap[k] = heap[p];
-            heap[p] = temp;
+            heap[p] = std::move(heap[k]);
             p = k;
         }
+        heap[p] = std::move(val);
     }
 
     template <typename T>
     void MinHeap<T>::siftUp(int start) {
+        T val = std::move(heap[start]);
         int p = start;
         while (p > 0) {
             int k = (p - 1) / 2;
-            if (heap[p] > heap[k])
+            if (!(val < heap[k]))
                 break;
-            T temp = heap[k];
-            heap[k] = heap[p];
-            heap[p] = temp;
+            heap[p] = std::move(heap[k]);
             p = k;
         }
+        heap[p] = std::move(val);
     }
 
     template <typename T>
@@ -159,7 +169,8 @@ namespace TinySTL {
         x = heap[0];
         heap[0] = heap[currentSize - 1];
         currentSize--;
-        siftDown(0, currentSize - 1);
+        if (currentSize > 0)
+            siftDown(0, currentSize - 1);
         return true;
     }
 
@@ -0,0 +1,154 @@
+#ifndef MMAP_ALLOCATOR_HPP
+#define MMAP_ALLOCATOR_HPP
+
+// Allocator for huge buffers
+//
+// Requests of at least Threshold bytes are served by anonymous mmap and
+// released with munmap, everything smaller goes to ::operator new. The
+// allocator also provides reallocate(), which vector uses instead of
+// allocate-copy-free for trivially relocatable elements: on Linux a mapped
+// buffer grows with mremap, so the kernel moves page table entries rather
+// than copying the data and RSS never holds two copies of the buffer.
+// With HugePages set, mappings are advised for transparent huge pages.
+//
+// On systems without mremap the mapping is copied; without mmap at all the
+// allocator degrades to ::operator new.
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include "Allocator.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define TINYSTL_HAS_MMAP 1
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace TinySTL {
+
+    template <typename T, std::size_t Threshold = ((std::size_t)1 << 21), bool HugePages = false>
+    class mmap_allocator : public allocator_base<T> {
+    public:
+        using typename allocator_base<T>::pointer;
+        using typename allocator_base<T>::size_type;
+
+        template <typename U> struct rebind {
+            typedef mmap_allocator<U, Threshold, HugePages> other;
+        };
+
+    public:
+        mmap_allocator() noexcept { }
+        template <typename U>
+        mmap_allocator(const mmap_allocator<U, Threshold, HugePages>&) noexcept { }
+
+        pointer allocate(size_type num, const void* = 0) {
+            std::size_t bytes = num * sizeof(T);
+            if (!isMapped(bytes)) {
+                return static_cast<pointer>(::operator new(bytes));
+            }
+            return static_cast<pointer>(map(bytes));
+        }
+
+        void deallocate(pointer p, size_type num) {
+            std::size_t bytes = num * sizeof(T);
+            if (!isMapped(bytes)) {
+                ::operator delete(static_cast<void*>(p));
+                return;
+            }
+            unmap(p, bytes);
+        }
+
+        // Resize the buffer p of oldNum elements to newNum elements, keeping
+        // the first min(oldNum, newNum) elements bitwise. Only valid for
+        // trivially relocatable T; p must not be used afterwards. The bytes
+        // copied (0 when the mapping is moved by mremap) go to *bytesCopied.
+        pointer reallocate(pointer p, size_type oldNum, size_type newNum,
+                           size_type* bytesCopied = nullptr) {
+            std::size_t oldBytes = oldNum * sizeof(T);
+            std::size_t newBytes = newNum * sizeof(T);
+#if defined(__linux__)
+            if (isMapped(oldBytes) && isMapped(newBytes)) {
+                void* q = ::mremap(p, pageRound(oldBytes), pageRound(newBytes), MREMAP_MAYMOVE);
+                if (q == MAP_FAILED) {
+                    throw std::bad_alloc();
+                }
+                adviseHugePages(q, newBytes);
+                if (bytesCopied != nullptr) {
+                    *bytesCopied = 0;
+                }
+                return static_cast<pointer>(q);
+            }
+#endif
+            pointer q = allocate(newNum);
+            std::size_t copied = oldBytes < newBytes ? oldBytes : newBytes;
+            std::memcpy(static_cast<void*>(q), static_cast<const void*>(p), copied);
+            deallocate(p, oldNum);
+            if (bytesCopied != nullptr) {
+                *bytesCopied = copied;
+            }
+            return q;
+        }
+
+        static bool isMapped(std::size_t bytes) {
+#if defined(TINYSTL_HAS_MMAP)
+            return bytes >= Threshold;
+#else
+            (void)bytes;
+            return false;
+#endif
+        }
+
+    private:
+        static std::size_t pageRound(std::size_t bytes) {
+#if defined(TINYSTL_HAS_MMAP)
+            static const std::size_t pageSize = (std::size_t)::sysconf(_SC_PAGESIZE);
+            return (bytes + pageSize - 1) / pageSize * pageSize;
+#else
+            return bytes;
+#endif
+        }
+
+        static void* map(std::size_t bytes) {
+#if defined(TINYSTL_HAS_MMAP)
+            void* p = ::mmap(nullptr, pageRound(bytes), PROT_READ | PROT_WRITE,
+                             MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (p == MAP_FAILED) {
+                throw std::bad_alloc();
+            }
+            adviseHugePages(p, bytes);
+            return p;
+#else
+            return ::operator new(bytes);
+#endif
+        }
+
+        static void unmap(void* p, std::size_t bytes) {
+#if defined(TINYSTL_HAS_MMAP)
+            ::munmap(p, pageRound(bytes));
+#else
+            (void)bytes;
+            ::operator delete(p);
+#endif
+        }
+
+        static void adviseHugePages(void* p, std::size_t bytes) {
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+            if (HugePages) {
+                ::madvise(p, pageRound(bytes), MADV_HUGEPAGE);
+            }
+#else
+            (void)p;
+            (void)bytes;
+#endif
+        }
+    };
+
+    template <typename T, typename U, std::size_t N, bool H>
+    bool operator==(const mmap_allocator<T, N, H>&, const mmap_allocator<U, N, H>&) { return true; }
+    template <typename T, typename U, std::size_t N, bool H>
+    bool operator!=(const mmap_allocator<T, N, H>&, const mmap_allocator<U, N, H>&) { return false; }
+
+}  // namespace TinySTL
+
+#endif  // MMAP_ALLOCATOR_HPP
@@ -0,0 +1,78 @@
+#ifndef PARALLEL_HPP
+#define PARALLEL_HPP
+
+// Minimal fork-join helper for the parallel algorithms
+
+#include <cstddef>
+#include <thread>
+#include "Vector.hpp"
+
+namespace TinySTL {
+
+    // number of worker threads to use when the caller asks for 0
+    inline unsigned defaultThreads() {
+        unsigned n = std::thread::hardware_concurrency();
+        return n == 0 ? 1 : n;
+    }
+
+    // Split [0, count) into at most threads contiguous chunks whose
+    // boundaries are multiples of grain, and call f(thread, begin, end) for
+    // each chunk on its own thread (the last one on the calling thread).
+    // Returns once all chunks are done.
+    template <typename Function>
+    void parallelFor(std::size_t count, unsigned threads, Function f, std::size_t grain = 1) {
+        if (threads == 0) {
+            threads = defaultThreads();
+        }
+        std::size_t chunk = (count + threads - 1) / threads;
+        chunk = (chunk + grain - 1) / grain * grain;
+        if (threads == 1 || chunk >= count) {
+            f(0u, (std::size_t)0, count);
+            return;
+        }
+        TinySTL::vector<std::thread*> workers;
+        unsigned t = 0;
+        std::size_t begin = 0;
+        for (; begin + chunk < count; begin += chunk, ++t) {
+            workers.push_back(new std::thread(f, t, begin, begin + chunk));
+        }
+        f(t, begin, count);
+        for (std::size_t i = 0; i < workers.size(); ++i) {
+            workers[i]->join();
+            delete workers[i];
+        }
+    }
+
+    // Replace first[0, count) by its inclusive prefix sums: each chunk is
+    // summed on its own thread, the chunk totals are scanned, and a second
+    // parallel pass adds each chunk's base to its elements.
+    template <typename T>
+    void parallelInclusiveScan(T* first, std::size_t count, unsigned threads,
+                               std::size_t grain = 4096) {
+        if (threads == 0) {
+            threads = defaultThreads();
+        }
+        TinySTL::vector<T> base(threads + 1, T());
+        parallelFor(count, threads, [&](unsigned t, std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin + 1; i < end; ++i) {
+                first[i] += first[i - 1];
+            }
+            base[t + 1] = begin < end ? first[end - 1] : T();
+        }, grain);
+        for (unsigned t = 1; t <= threads; ++t) {
+            base[t] += base[t - 1];
+        }
+        parallelFor(count, threads, [&](unsigned t, std::size_t begin, std::size_t end) {
+            if (t == 0) {
+                return;
+            }
+            for (std::size_t i = begin; i < end; ++i) {
+                first[i] += base[t];
+            }
+        }, grain);
+    }
+
+} // namespace TinySTL
+
+
+#endif // PARALLEL_HPP
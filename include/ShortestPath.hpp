@@ -0,0 +1,216 @@
+#ifndef SHORTEST_PATH_HPP
+#define SHORTEST_PATH_HPP
+
+// Single-source shortest paths over non-negative edge weights
+//
+// Both algorithms take any graph class with numOfVertices(), an edge_type
+// typedef and neighbours(v) ranges yielding .dest/.weight (GraphAdj,
+// GraphCSR, or a plain Graph reference through its generic range).
+//
+// dijkstra: sequential, with an indexed_priority_queue holding each vertex
+// at most once, so a shorter path is a decrease-key in O(log n) instead of
+// a scan or a duplicate entry.
+//
+// deltaStepping: parallel (Meyer & Sanders). Vertices are kept in buckets
+// of width delta by tentative distance. The lowest non-empty bucket is
+// settled by relaxing light edges (weight <= delta) in parallel rounds
+// until it stays empty, then the heavy edges of everything it settled are
+// relaxed once. Distances are lowered with a CAS, parents are derived
+// from the final distances afterwards.
+
+#include "Parallel.hpp"
+#include "priority_queue.hpp"
+#include "Vector.hpp"
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <limits>
+
+namespace TinySTL {
+
+template <typename EdgeType>
+struct ShortestPaths {
+    TinySTL::vector<EdgeType> dist;  // unreachable(): no path
+    TinySTL::vector<int> parent;     // -1 if unreached, parent[source] == source
+
+    static EdgeType unreachable() { return std::numeric_limits<EdgeType>::max(); }
+};
+
+namespace detail {
+
+template <typename T>
+struct AtomicValue {
+    std::atomic<T> value;
+    AtomicValue() : value(T()) {}
+    // vector copy-constructs its elements; only used before sharing
+    AtomicValue(const AtomicValue &x) : value(x.value.load(std::memory_order_relaxed)) {}
+};
+
+}  // namespace detail
+
+template <typename GraphType>
+ShortestPaths<typename GraphType::edge_type> dijkstra(const GraphType &g, int source) {
+    typedef typename GraphType::edge_type E;
+    size_t n = g.numOfVertices();
+    assert(0 <= source && source < (int)n);
+
+    ShortestPaths<E> result;
+    result.dist.assign(n, ShortestPaths<E>::unreachable());
+    result.parent.assign(n, -1);
+    result.dist[source] = E();
+    result.parent[source] = source;
+
+    // vertex ids are the heap handles
+    indexed_priority_queue<E> heap;
+    heap.reserve(n);
+    heap.push(source, E());
+    while (!heap.empty()) {
+        int v = heap.top_handle();
+        E d = heap.top();
+        heap.pop();
+        for (const auto &e : g.neighbours(v)) {
+            E nd = d + e.weight;
+            if (nd < result.dist[e.dest]) {
+                if (heap.contains(e.dest)) {
+                    heap.decreaseKey(e.dest, nd);
+                } else {
+                    heap.push(e.dest, nd);
+                }
+                result.dist[e.dest] = nd;
+                result.parent[e.dest] = v;
+            }
+        }
+    }
+    return result;
+}
+
+// delta == 0 picks the average edge weight; threads == 0 uses one per core
+template <typename GraphType>
+ShortestPaths<typename GraphType::edge_type> deltaStepping(
+    const GraphType &g, int source, typename GraphType::edge_type delta = typename GraphType::edge_type(),
+    unsigned threads = 0) {
+    typedef typename GraphType::edge_type E;
+    size_t n = g.numOfVertices();
+    assert(0 <= source && source < (int)n);
+    if (threads == 0) {
+        threads = defaultThreads();
+    }
+    if (!(E() < delta)) {
+        E total = E();
+        size_t m = 0;
+        for (size_t v = 0; v < n; v++) {
+            for (const auto &e : g.neighbours(v)) {
+                total += e.weight;
+                m++;
+            }
+        }
+        delta = m == 0 ? E(1) : E(total / (E)m);
+        if (!(E() < delta)) {
+            delta = E(1);
+        }
+    }
+
+    const E inf = ShortestPaths<E>::unreachable();
+    TinySTL::vector<detail::AtomicValue<E> > dist(n);
+    for (size_t v = 0; v < n; v++) {
+        dist[v].value.store(inf, std::memory_order_relaxed);
+    }
+    dist[source].value.store(E(), std::memory_order_relaxed);
+    auto bucketOf = [&](int v) { return (size_t)(dist[v].value.load(std::memory_order_relaxed) / delta); };
+
+    TinySTL::vector<TinySTL::vector<int> > buckets(1);
+    buckets[0].push_back(source);
+    TinySTL::vector<int> stamp(n, -1);  // last round that took the vertex
+    int round = 0;
+
+    // relax the light (or heavy) edges of frontier in parallel and file
+    // every vertex whose distance dropped into its bucket
+    TinySTL::vector<TinySTL::vector<int> > improved(threads);
+    auto relax = [&](const TinySTL::vector<int> &frontier, bool light) {
+        parallelFor(frontier.size(), threads, [&](unsigned t, size_t begin, size_t end) {
+            TinySTL::vector<int> &out = improved[t];
+            for (size_t i = begin; i < end; i++) {
+                int v = frontier[i];
+                E d = dist[v].value.load(std::memory_order_relaxed);
+                for (const auto &e : g.neighbours(v)) {
+                    if ((e.weight <= delta) != light) {
+                        continue;
+                    }
+                    E nd = d + e.weight;
+                    std::atomic<E> &target = dist[e.dest].value;
+                    E cur = target.load(std::memory_order_relaxed);
+                    while (nd < cur) {
+                        if (target.compare_exchange_weak(cur, nd, std::memory_order_relaxed)) {
+                            out.push_back(e.dest);
+                            break;
+                        }
+                    }
+                }
+            }
+        }, 256);  // small frontiers are relaxed on the calling thread
+        for (unsigned t = 0; t < threads; t++) {
+            for (size_t i = 0; i < improved[t].size(); i++) {
+                int u = improved[t][i];
+                size_t b = bucketOf(u);
+                if (b >= buckets.size()) {
+                    buckets.resize(b + 1);
+                }
+                buckets[b].push_back(u);
+            }
+            improved[t].clear();
+        }
+    };
+
+    for (size_t i = 0; i < buckets.size(); i++) {
+        TinySTL::vector<int> settled;
+        while (!buckets[i].empty()) {
+            // take the vertices still belonging to bucket i, once each
+            TinySTL::vector<int> frontier;
+            frontier.swap(buckets[i]);
+            size_t k = 0;
+            for (size_t j = 0; j < frontier.size(); j++) {
+                int v = frontier[j];
+                if (stamp[v] != round && bucketOf(v) == i) {
+                    stamp[v] = round;
+                    frontier[k++] = v;
+                }
+            }
+            frontier.resize(k);
+            round++;
+            for (size_t j = 0; j < frontier.size(); j++) {
+                settled.push_back(frontier[j]);
+            }
+            relax(frontier, true);
+        }
+        relax(settled, false);
+    }
+
+    ShortestPaths<E> result;
+    result.dist.resize(n);
+    for (size_t v = 0; v < n; v++) {
+        result.dist[v] = dist[v].value.load(std::memory_order_relaxed);
+    }
+    // every reached vertex ends a path of edges that are tight under the
+    // final distances; a search over tight edges from the source picks one
+    // (searching, rather than taking any tight edge, keeps zero-weight
+    // cycles out of the tree)
+    result.parent.assign(n, -1);
+    result.parent[source] = source;
+    TinySTL::vector<int> queue;
+    queue.push_back(source);
+    for (size_t head = 0; head < queue.size(); head++) {
+        int v = queue[head];
+        for (const auto &e : g.neighbours(v)) {
+            if (result.parent[e.dest] == -1 && result.dist[v] + e.weight == result.dist[e.dest]) {
+                result.parent[e.dest] = v;
+                queue.push_back(e.dest);
+            }
+        }
+    }
+    return result;
+}
+
+}  // namespace TinySTL
+
+#endif  // SHORTEST_PATH_HPP
@@ -0,0 +1,512 @@
+#ifndef SMALL_VECTOR_HPP
+#define SMALL_VECTOR_HPP
+
+// vector with inline storage for the first N elements
+//
+// small_vector has the interface of TinySTL::vector, but keeps up to N
+// elements in a buffer inside the object itself and only asks the allocator
+// for memory once it grows past N. Moving a small_vector that is still
+// inline relocates its elements, so iterators are not preserved by moves.
+
+#include <initializer_list>
+#include <stdexcept>
+#include <cassert>
+#include <type_traits>
+#include <utility>
+#include "Iterator.hpp"
+#include "Memory.hpp"
+
+namespace TinySTL {
+
+    template <typename T, std::size_t N, typename Alloc = TinySTL::allocator<T>>
+    class small_vector {
+       public:
+        using value_type      = T;
+        using allocator_type  = Alloc;
+        using reference       = value_type&;
+        using const_reference = const value_type&;
+        using pointer         = value_type*;
+        using const_pointer   = const value_type*;
+        using iterator        = value_type*;
+        using const_iterator  = const value_type*;
+        using difference_type = std::ptrdiff_t;
+        using size_type       = std::size_t;
+
+        static_assert(N > 0, "small_vector needs room for at least one inline element");
+
+       public:
+        // Initialize
+        explicit small_vector(const allocator_type& alloc = allocator_type());  // default (1)
+
+        explicit small_vector(size_type n);                                     // fill (2)
+                 small_vector(size_type n, const value_type& val,
+                              const allocator_type& alloc = allocator_type());
+
+        template <typename InputIterator, typename = typename TinySTL::Iterator::iterator_traits<InputIterator>::value_type>
+        small_vector(InputIterator first, InputIterator last,
+                     const allocator_type& alloc = allocator_type());     // range (3)
+
+        small_vector(const small_vector& x);                             // copy (4)
+
+        small_vector(small_vector&& x) noexcept(std::is_nothrow_move_constructible<T>::value); // move (5)
+
+        small_vector(std::initializer_list<value_type> il,
+                     const allocator_type& alloc = allocator_type());     // initializer list (6)
+
+        ~small_vector();
+
+        small_vector& operator=(const small_vector& rhs);
+        small_vector& operator=(small_vector&& rhs);
+
+        // Iterators:
+              iterator begin() noexcept       { return dbegin; }
+        const_iterator begin() const noexcept { return dbegin; }
+              iterator end()   noexcept       { return dend; }
+        const_iterator end()   const noexcept { return dend; }
+        const_iterator cbegin() const noexcept { return dbegin; }
+        const_iterator cend()   const noexcept { return dend; }
+
+        // Capacity
+        size_type size() const noexcept     { return dend - dbegin; }
+        size_type max_size() const noexcept { return (~(size_t)0); }
+        void resize(size_type n);
+        void resize(size_type n, const value_type& val);
+        size_type capacity() const noexcept { return endOfStorage - dbegin; }
+        bool empty() const noexcept         { return dend == dbegin; }
+        void reserve(size_type n);
+        // true while the elements live in the inline buffer
+        bool is_inline() const noexcept     { return dbegin == inlineData(); }
+        static constexpr size_type inline_capacity() { return N; }
+
+        // Element access:
+              reference operator[] (size_type n)        { return dbegin[n]; }
+        const_reference operator[] (size_type n) const  { return dbegin[n]; }
+              reference at (size_type n);
+        const_reference at (size_type n) const;
+              reference front()         { return *dbegin; }
+        const_reference front() const   { return *dbegin; }
+              reference back()          { return *(dend - 1); }
+        const_reference back() const    { return *(dend - 1); }
+              pointer   data() noexcept       { return dbegin; }
+        const_pointer   data() const noexcept { return dbegin; }
+
+        // Modifiers
+        template <typename InputIterator, typename = typename TinySTL::Iterator::iterator_traits<InputIterator>::value_type>
+        void assign(InputIterator first, InputIterator last);  // range (1)
+        void assign(size_type n, const value_type& val);       // fill  (2)
+        void assign(std::initializer_list<value_type> il);     // initializer list (3)
+
+        void push_back(const value_type& val);
+        void push_back(value_type&& val);
+
+        void pop_back();
+
+        iterator insert(const_iterator position, const value_type& val);  // single element (1)
+        iterator insert(const_iterator position, value_type&& val);       // move (4)
+
+        iterator erase(const_iterator position);
+        iterator erase(const_iterator first, const_iterator last);
+
+        void swap(small_vector& x);
+
+        void clear();
+
+        template <class... Args>
+        iterator emplace(const_iterator position, Args&&... args);
+
+        template <class... Args>
+        void emplace_back(Args&&... args);
+
+        // Allocator
+        allocator_type get_allocator() const noexcept { return alloc; }
+
+       private:
+              T* inlineData() noexcept       { return reinterpret_cast<T*>(&buffer); }
+        const T* inlineData() const noexcept { return reinterpret_cast<const T*>(&buffer); }
+        void destroyAll();
+        void releaseHeap();
+        void overflowHandle(size_type minSize = 1);
+
+       private:
+        // data stored in [dbegin, dend)
+        // buffer in [dbegin, endOfStorage) is either the inline one or heap
+        typename std::aligned_storage<sizeof(T) * N, alignof(T)>::type buffer;
+        T *dbegin, *dend, *endOfStorage;
+        allocator_type alloc;
+    };
+
+    // Non-member function overloads
+    template <typename T, std::size_t N, typename Alloc>
+    void swap(small_vector<T, N, Alloc>& lhs, small_vector<T, N, Alloc>& rhs);
+
+    template <typename T, std::size_t N, typename Alloc>
+    bool operator == (const small_vector<T, N, Alloc>& lhs, const small_vector<T, N, Alloc>& rhs);
+    template <typename T, std::size_t N, typename Alloc>
+    bool operator != (const small_vector<T, N, Alloc>& lhs, const small_vector<T, N, Alloc>& rhs);
+    template <typename T, std::size_t N, typename Alloc>
+    bool operator <  (const small_vector<T, N, Alloc>& lhs, const small_vector<T, N, Alloc>& rhs);
+
+}  // namespace TinySTL
+
+
+namespace TinySTL {
+
+    template <typename T, std::size_t N, typename Alloc>
+    small_vector<T, N, Alloc>::small_vector(const allocator_type& alloc_)
+        : dbegin(inlineData()),
+          dend(inlineData()),
+          endOfStorage(inlineData() + N),
+          alloc(alloc_) {
+    }
+
+    template <typename T, std::size_t N, typename Alloc>
+    small_vector<T, N, Alloc>::small_vector(size_type n)
+        : small_vector() {
+        resize(n);
+    }
+
+    template <typename T, std::size_t N, typename Alloc>
+    small_vector<T, N, Alloc>::small_vector(size_type n, const value_type& val, const allocator_type& alloc_)
+        : small_vector(alloc_) {
+        resize(n, val);
+    }
+
+    template <typename T, std::size_t N, typename Alloc>
+    template <typename InputIterator, typename >
+    small_vector<T, N, Alloc>::small_vector(InputIterator first, InputIterator last, const allocator_type& alloc_)
+        : small_vector(alloc_) {
+        assign(first, last);
+    }
+
+    template <typename T, std::size_t N, typename Alloc>
+    small_vector<T, N, Alloc>::small_vector(const small_vector& x)
+        : small_vector(x.alloc) {
+        assign(x.dbegin, x.dend);
+    }
+
+    template <typename T, std::size_t N, typename Alloc>
+    small_vector<T, N, Alloc>::small_vector(small_vector&& x) noexcept(std::is_nothrow_move_constructible<T>::value)
+        : small_vector(x.alloc) {
+        if (x.is_inline()) {
+            dend = TinySTL::uninitialized_relocate_n(x.dbegin, x.size(), dbegin);
+            x.dend = x.dbegin;
+        } else {
+            // steal the heap buffer, x falls back to its inline storage
+            dbegin       = x.dbegin;
+            dend         = x.dend;
+            endOfStorage = x.endOfStorage;
+            x.dbegin = x.dend = x.inlineData();
+            x.endOfStorage    = x.inlineData() + N;
+        }
+    }
+
+    template <typename T, std::size_t N, typename Alloc>
+    small_vector<T, N, Alloc>::small_vector(std::initializer_list<value_type> il, const allocator_type& alloc_)
+        : small_vector(alloc_) {
+        assign(il.begin(), il.end());
+    }
+
+    template <typename T, std::size_t N, typename Alloc>
+    small_vector<T, N, Alloc>::~small_vector() {
+        clear();
+    }
+
+    template <typename T, std::size_t N, typename Alloc>
+    small_vector<T, N, Alloc>& small_vector<T, N, Alloc>::operator=(const small_vector& x) {
+        if (&x != this) {
+            assign(x.dbegin, x.dend);
+        }
+        return *this;
+    }
+
+    template <typename T, std::size_t N, typename Alloc>
+    small_vector<T, N, Alloc>& small_vector<T, N, Alloc>::operator=(small_vector&& x) {
+        if (&x != this) {
+            clear();
+            alloc = x.alloc;
+            if (x.is_inline()) {
+                dend = TinySTL::uninitialized_relocate_n(x.dbegin, x.size(), dbegin);
+                x.dend = x.dbegin;
+            } else {
+                dbegin       = x.dbegin;
+                dend         = x.dend;
+                endOfStorage = x.endOfStorage;
+                x.dbegin = x.dend = x.inlineData();
+                x.endOfStorage    = x.inlineData() + N;
+            }
+        }
+        return *this;
+    }
+
+    template <typename T, std::size_t N, typename Alloc>
+    void small_vector<T, N, Alloc>::resize(size_type n) {
+        size_type currentSize = size();
+        if (n <= currentSize) {
+            for (T* p = dbegin + n; p != dend; ++p) {
+                alloc.destroy(p);
+            }
+            dend = dbegin + n;
+        } else {
+            reserve(n);
+            for (; dend != dbegin + n; ++dend) {
+                alloc.construct(dend);
+            }
+        }
+    }
+
+    template <typename T, std::size_t N, typename Alloc>
+    void small_vector<T, N, Alloc>::resize(size_type n, const value_type& val) {
+        size_type currentSize = size();
+        if (n <= currentSize) {
+            for (T* p = dbegin + n; p != dend; ++p) {
+                alloc.destroy(p);
+            }
+            dend = dbegin + n;
+        } else {
+            value_type tmp(val);
+            reserve(n);
+            TinySTL::uninitialized_fill(dend, dbegin + n, tmp);
+            dend = dbegin + n;
+        }
+    }
+
+    template <typename T, std::size_t N, typename Alloc>
+    void small_vector<T, N, Alloc>::reserve(size_type n) {
+        size_type currentSize = size();
+        size_type maxSize     = capacity();
+        if (n > maxSize) {
+            T* newBegin = alloc.allocate(n);
+            try {
+                TinySTL::uninitialized_relocate_n(dbegin, currentSize, newBegin);
+            } catch (...) {
+                alloc.deallocate(newBegin, n);
+                throw;
+            }
+            releaseHeap();
+            dbegin       = newBegin;
+            dend         = dbegin + currentSize;
+            endOfStorage = dbegin + n;
+        }
+    }
+
+    template <typename T, std::size_t N, typename Alloc>
+    typename small_vector<T, N, Alloc>::reference small_vector<T, N, Alloc>::at(size_type n) {
+        if (n >= size()) {
+            throw std::out_of_range("index is out of range");
+        }
+        return dbegin[n];
+    }
+
+    template <typename T, std::size_t N, typename Alloc>
+    typename small_vector<T, N, Alloc>::const_reference small_vector<T, N, Alloc>::at(size_type n) const {
+        if (n >= size()) {
+            throw std::out_of_range("index is out of range");
+        }
+        return dbegin[n];
+    }
+
+    template <typename T, std::size_t N, typename Alloc>
+    template <class InputIterator, typename >
+    void small_vector<T, N, Alloc>::assign(InputIterator first, InputIterator last) {
+        size_type n = last - first;
+        destroyAll();
+        if (n > capacity()) {
+            reserve(n);
+        }
+        dend = TinySTL::uninitialized_copy(first, last, dbegin);
+    }
+
+    template <typename T, std::size_t N, typename Alloc>
+    void small_vector<T, N, Alloc>::assign(size_type n, const value_type& val) {
+        value_type tmp(val);
+        destroyAll();
+        if (n > capacity()) {
+            reserve(n);
+        }
+        dend = TinySTL::uninitialized_fill_n(dbegin, n, tmp);
+    }
+
+    template <typename T, std::size_t N, typename Alloc>
+    void small_vector<T, N, Alloc>::assign(std::initializer_list<value_type> il) {
+        assign(il.begin(), il.end());
+    }
+
+    template <typename T, std::size_t N, typename Alloc>
+    void small_vector<T, N, Alloc>::push_back(const value_type& val) {
+        if (dend == endOfStorage) {
+            // val may live in the buffer that is about to be relocated
+            value_type tmp(val);
+            overflowHandle();
+            alloc.construct(dend, std::move(tmp));
+        } else {
+            alloc.construct(dend, val);
+        }
+        dend++;
+    }
+
+    template <typename T, std::size_t N, typename Alloc>
+    void small_vector<T, N, Alloc>::push_back(value_type&& val) {
+        if (dend == endOfStorage) {
+            overflowHandle();
+        }
+        alloc.construct(dend, std::move(val));
+        dend++;
+    }
+
+    template <typename T, std::size_t N, typename Alloc>
+    void small_vector<T, N, Alloc>::pop_back() {
+        if (size() == 0) {
+            return;
+        }
+        dend--;
+        alloc.destroy(dend);
+    }
+
+    template <typename T, std::size_t N, typename Alloc>
+    typename small_vector<T, N, Alloc>::iterator
+    small_vector<T, N, Alloc>::insert(const_iterator position, const value_type& val) {
+        return emplace(position, val);
+    }
+
+    template <typename T, std::size_t N, typename Alloc>
+    typename small_vector<T, N, Alloc>::iterator
+    small_vector<T, N, Alloc>::insert(const_iterator position, value_type&& val) {
+        return emplace(position, std::move(val));
+    }
+
+    template <typename T, std::size_t N, typename Alloc>
+    typename small_vector<T, N, Alloc>::iterator
+    small_vector<T, N, Alloc>::erase(const_iterator position) {
+        return erase(position, position + 1);
+    }
+
+    template <typename T, std::size_t N, typename Alloc>
+    typename small_vector<T, N, Alloc>::iterator
+    small_vector<T, N, Alloc>::erase(const_iterator first, const_iterator last) {
+        assert(first >= dbegin);
+        assert(first <= last);
+        assert(last <= dend);
+        T* dst = dbegin + (first - dbegin);
+        T* src = dbegin + (last - dbegin);
+        if (dst == src) {
+            return dst;
+        }
+        for (; src != dend; ++dst, ++src) {
+            *dst = std::move(*src);
+        }
+        for (T* p = dst; p != dend; ++p) {
+            alloc.destroy(p);
+        }
+        dend = dst;
+        return dbegin + (first - dbegin);
+    }
+
+    template <typename T, std::size_t N, typename Alloc>
+    void small_vector<T, N, Alloc>::swap(small_vector& x) {
+        small_vector tmp(std::move(x));
+        x     = std::move(*this);
+        *this = std::move(tmp);
+    }
+
+    template <typename T, std::size_t N, typename Alloc>
+    void small_vector<T, N, Alloc>::clear() {
+        destroyAll();
+        releaseHeap();
+        dbegin = dend = inlineData();
+        endOfStorage  = inlineData() + N;
+    }
+
+    template <typename T, std::size_t N, typename Alloc>
+    template <class... Args>
+    typename small_vector<T, N, Alloc>::iterator
+    small_vector<T, N, Alloc>::emplace(const_iterator position, Args&&... args) {
+        size_type pos = position - begin();
+        value_type tmp(std::forward<Args>(args)...);
+        if (dend == endOfStorage) {
+            overflowHandle();
+        }
+        if (pos == size()) {
+            alloc.construct(dend, std::move(tmp));
+        } else {
+            // open a gap at pos by shifting the tail one slot to the right
+            alloc.construct(dend, std::move(*(dend - 1)));
+            for (T* p = dend - 1; p != dbegin + pos; --p) {
+                *p = std::move(*(p - 1));
+            }
+            dbegin[pos] = std::move(tmp);
+        }
+        dend++;
+        return dbegin + pos;
+    }
+
+    template <typename T, std::size_t N, typename Alloc>
+    template <class... Args>
+    void small_vector<T, N, Alloc>::emplace_back(Args&&... args) {
+        if (dend == endOfStorage) {
+            overflowHandle();
+        }
+        alloc.construct(dend, std::forward<Args>(args)...);
+        dend++;
+    }
+
+    template <typename T, std::size_t N, typename Alloc>
+    void small_vector<T, N, Alloc>::destroyAll() {
+        for (T* p = dbegin; p != dend; ++p) {
+            alloc.destroy(p);
+        }
+        dend = dbegin;
+    }
+
+    template <typename T, std::size_t N, typename Alloc>
+    void small_vector<T, N, Alloc>::releaseHeap() {
+        if (!is_inline()) {
+            alloc.deallocate(dbegin, capacity());
+        }
+    }
+
+    template <typename T, std::size_t N, typename Alloc>
+    void small_vector<T, N, Alloc>::overflowHandle(size_type minSize) {
+        size_type allocSize = 2 * capacity();
+        if (allocSize < minSize) {
+            allocSize = minSize;
+        }
+        reserve(allocSize);
+    }
+
+    template <typename T, std::size_t N, typename Alloc>
+    void swap(small_vector<T, N, Alloc>& lhs, small_vector<T, N, Alloc>& rhs) {
+        lhs.swap(rhs);
+    }
+
+    template <typename T, std::size_t N, typename Alloc>
+    bool operator==(const small_vector<T, N, Alloc>& lhs, const small_vector<T, N, Alloc>& rhs) {
+        if (lhs.size() != rhs.size()) {
+            return false;
+        }
+        for (size_t i = 0; i < lhs.size(); ++i) {
+            if (lhs[i] != rhs[i])
+                return false;
+        }
+        return true;
+    }
+
+    template <typename T, std::size_t N, typename Alloc>
+    bool operator!=(const small_vector<T, N, Alloc>& lhs, const small_vector<T, N, Alloc>& rhs) {
+        return !(lhs == rhs);
+    }
+
+    template <typename T, std::size_t N, typename Alloc>
+    bool operator<(const small_vector<T, N, Alloc>& lhs, const small_vector<T, N, Alloc>& rhs) {
+        size_t length = lhs.size() < rhs.size() ? lhs.size() : rhs.size();
+        for (size_t i = 0; i < length; ++i) {
+            if (lhs[i] < rhs[i])
+                return true;
+            else if (rhs[i] < lhs[i])
+                return false;
+        }
+        return lhs.size() < rhs.size();
+    }
+
+}  // namespace TinySTL
+
+#endif  // SMALL_VECTOR_HPP
@@ -38,7 +38,7 @@ namespace TinySTL {
 
         void pop() { data.pop_back(); }
 
-        void swap(stack& x) noexcept { data.swap(x); }
+        void swap(stack& x) noexcept { data.swap(x.data); }
 
     private:
         container_type data;
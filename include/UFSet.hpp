@@ -1,17 +1,41 @@
 #ifndef UFSET_HPP
 #define UFSET_HPP
 
+#include <utility>
 #include "Vector.hpp"
 
 namespace TinySTL {
 
-    class UFSet {
+    // Linking policies for BasicUFSet. A root always stores a negative
+    // parent; UnionBySize keeps -size there, UnionByRank keeps -1 and a
+    // rank byte per element in a separate array, so parent stays a dense
+    // int array and the rank bytes only get touched by Union.
+    struct UnionBySize { };
+    struct UnionByRank { };
+
+    template <typename Linking = UnionBySize>
+    class BasicUFSet {
     public:
         using size_type = std::size_t;
 
     public:
-        explicit UFSet(size_type n) {
+        explicit BasicUFSet(size_type n) {
             parent.assign(n, -1);
+            initRank(n, Linking());
+        }
+
+        // Find halves the path it walks (every node is pointed at its
+        // grandparent). The const overloads leave the trees alone, so
+        // concurrent readers of a const set do not race.
+        int Find(int x) {
+            while (parent[x] >= 0) {
+                int p = parent[x];
+                if (parent[p] >= 0) {
+                    parent[x] = parent[p];
+                }
+                x = parent[x];
+            }
+            return x;
         }
 
         int Find(int x) const {
@@ -21,6 +45,10 @@ namespace TinySTL {
             return x;
         }
 
+        bool inSame(int x1, int x2) {
+            return Find(x1) == Find(x2);
+        }
+
         bool inSame(int x1, int x2) const {
             return Find(x1) == Find(x2);
         }
@@ -31,6 +59,26 @@ namespace TinySTL {
             if (root1 == root2) {
                 return;
             }
+            link(root1, root2, Linking());
+        }
+
+        // point every element straight at its root, so that until the next
+        // Union a Find is one hop
+        void compact() {
+            for (size_type i = 0; i < parent.size(); ++i) {
+                if (parent[i] >= 0) {
+                    parent[i] = Find(parent[i]);
+                }
+            }
+        }
+
+        size_type size() const { return parent.size(); }
+
+    private:
+        void initRank(size_type, UnionBySize) { }
+        void initRank(size_type n, UnionByRank) { rank.assign(n, 0); }
+
+        void link(int root1, int root2, UnionBySize) {
             if (parent[root1] < parent[root2]) {
                 parent[root1] += parent[root2];
                 parent[root2] = root1;
@@ -41,13 +89,100 @@ namespace TinySTL {
             }
         }
 
+        void link(int root1, int root2, UnionByRank) {
+            if (rank[root1] < rank[root2]) {
+                parent[root1] = root2;
+            }
+            else {
+                if (rank[root1] == rank[root2]) {
+                    ++rank[root1];
+                }
+                parent[root2] = root1;
+            }
+        }
+
+    private:
+        TinySTL::vector<int> parent;
+        TinySTL::vector<unsigned char> rank;    // UnionByRank only
+    };
+
+    using UFSet = BasicUFSet<UnionBySize>;
+    using RankedUFSet = BasicUFSet<UnionByRank>;
+
+    // Union-find whose unions can be undone, for offline dynamic
+    // connectivity and speculative merges. Union by size without path
+    // compression keeps every tree O(log n) deep and makes each Union a
+    // change to exactly two entries, which is recorded in an undo log.
+    // checkpoint() names the current state and rollback() returns to it,
+    // undoing the unions made since in O(1) each.
+    class RollbackUFSet {
+    public:
+        using size_type = std::size_t;
+
+    public:
+        explicit RollbackUFSet(size_type n) : numSets(n) {
+            parent.assign(n, -1);
+        }
+
+        int Find(int x) const {
+            while (parent[x] >= 0) {
+                x = parent[x];
+            }
+            return x;
+        }
+
+        bool inSame(int x1, int x2) const {
+            return Find(x1) == Find(x2);
+        }
+
+        // returns false (and logs nothing) if x1 and x2 were already joined
+        bool Union(int x1, int x2) {
+            int root1 = Find(x1);
+            int root2 = Find(x2);
+            if (root1 == root2) {
+                return false;
+            }
+            if (parent[root1] > parent[root2]) {
+                std::swap(root1, root2);
+            }
+            // hang the smaller tree root2 under root1
+            history.push_back(Change{ root2, parent[root2] });
+            parent[root1] += parent[root2];
+            parent[root2] = root1;
+            --numSets;
+            return true;
+        }
+
+        size_type checkpoint() const { return history.size(); }
+
+        // undo every Union made since checkpoint cp was taken
+        void rollback(size_type cp) {
+            while (history.size() > cp) {
+                const Change& change = history.back();
+                int root = parent[change.child];
+                parent[root] -= change.childSize;
+                parent[change.child] = change.childSize;
+                ++numSets;
+                history.pop_back();
+            }
+        }
+
+        size_type components() const { return numSets; }
         size_type size() const { return parent.size(); }
- 
+
+    private:
+        struct Change {
+            int child;       // former root linked below another root
+            int childSize;   // its parent entry before the link (-size)
+        };
+
     private:
         TinySTL::vector<int> parent;
+        TinySTL::vector<Change> history;
+        size_type numSets;
     };
 
-} // namespace TinySTL 
+} // namespace TinySTL
 
 
-#endif // UFSET_HPP
\ No newline at end of file
+#endif // UFSET_HPP
@@ -1,19 +1,105 @@
 #ifndef VECTOR_HPP
 #define VECTOR_HPP
 
+#include <atomic>
 #include <initializer_list>
 #include <stdexcept>
 #include <cassert>
 #include "Iterator.hpp"
 #include "Memory.hpp"
+#include "type_traits.hpp"
 
 namespace TinySTL {
     
-    template <typename T, typename Alloc = TinySTL::allocator<T>>
+    // Growth policies
+    //
+    // A policy decides the new capacity when a vector runs out of room and
+    // is told about every reallocation:
+    //   static size_t grow(size_t capacity, size_t minSize, size_t elemSize);
+    //   static void onReallocate(size_t oldBytes, size_t newBytes,
+    //                            size_t bytesMoved);
+    // bytesMoved counts the element bytes actually copied, so a buffer that
+    // an allocator grows by remapping (mmap_allocator) reports 0.
+
+    // multiply the capacity by Num / Den
+    template <std::size_t Num, std::size_t Den>
+    struct factor_growth {
+        static_assert(Num > Den, "growth factor must be greater than one");
+
+        static std::size_t grow(std::size_t capacity, std::size_t minSize, std::size_t) {
+            std::size_t allocSize = capacity * Num / Den;
+            if (allocSize <= capacity) {
+                allocSize = capacity + 1;
+            }
+            return allocSize < minSize ? minSize : allocSize;
+        }
+
+        static void onReallocate(std::size_t, std::size_t, std::size_t) { }
+    };
+
+    using growth_2x   = factor_growth<2, 1>;
+    using growth_1_5x = factor_growth<3, 2>;
+
+    // Small buffers grow with Base; once a buffer reaches Threshold bytes its
+    // size is rounded up to whole pages, so huge buffers carry no partial
+    // page slack and map cleanly onto the page allocator.
+    template <std::size_t PageSize = 4096, std::size_t Threshold = ((std::size_t)1 << 20),
+              typename Base = growth_1_5x>
+    struct page_growth {
+        static std::size_t grow(std::size_t capacity, std::size_t minSize, std::size_t elemSize) {
+            std::size_t allocSize = Base::grow(capacity, minSize, elemSize);
+            std::size_t bytes     = allocSize * elemSize;
+            if (bytes < Threshold) {
+                return allocSize;
+            }
+            bytes = (bytes + PageSize - 1) / PageSize * PageSize;
+            return bytes / elemSize;
+        }
+
+        static void onReallocate(std::size_t, std::size_t, std::size_t) { }
+    };
+
+    // counters shared by every vector using the same counted_growth policy
+    struct growth_stats {
+        std::atomic<std::size_t> reallocations;  // buffers replaced
+        std::atomic<std::size_t> bytesMoved;     // element bytes copied
+        std::atomic<std::size_t> bytesAllocated; // sum of new buffer sizes
+    };
+
+    // Policy wrapper that counts reallocations and copied bytes, e.g.
+    //   vector<int, allocator<int>, counted_growth<growth_1_5x>> v;
+    //   counted_growth<growth_1_5x>::stats().reallocations
+    template <typename Policy>
+    struct counted_growth {
+        static std::size_t grow(std::size_t capacity, std::size_t minSize, std::size_t elemSize) {
+            return Policy::grow(capacity, minSize, elemSize);
+        }
+
+        static void onReallocate(std::size_t oldBytes, std::size_t newBytes, std::size_t bytesMoved) {
+            Policy::onReallocate(oldBytes, newBytes, bytesMoved);
+            stats().reallocations.fetch_add(1, std::memory_order_relaxed);
+            stats().bytesMoved.fetch_add(bytesMoved, std::memory_order_relaxed);
+            stats().bytesAllocated.fetch_add(newBytes, std::memory_order_relaxed);
+        }
+
+        static growth_stats& stats() {
+            static growth_stats counters{ {0}, {0}, {0} };
+            return counters;
+        }
+
+        static void reset() {
+            stats().reallocations  = 0;
+            stats().bytesMoved     = 0;
+            stats().bytesAllocated = 0;
+        }
+    };
+
+    template <typename T, typename Alloc = TinySTL::allocator<T>, typename Growth = growth_2x>
     class vector {
        public:
         using value_type      = T;
         using allocator_type  = Alloc;
+        using growth_policy   = Growth;
         using reference       = value_type&;
         using const_reference = const value_type&;
         using pointer         = value_type*;
@@ -37,9 +123,11 @@ namespace TinySTL {
         vector(InputIterator first, InputIterator last,
                const allocator_type& alloc = allocator_type());  // range (3)
 
-        vector(const vector& x, const allocator_type& alloc = allocator_type()); // copy (4)
+        vector(const vector& x);                                         // copy (4)
+        vector(const vector& x, const allocator_type& alloc);
 
-        vector(vector&& x, const allocator_type& alloc = allocator_type()); // move (5)
+        vector(vector&& x) noexcept;                                     // move (5)
+        vector(vector&& x, const allocator_type& alloc);  // moves elements one by one if alloc != x's
 
         vector(std::initializer_list<value_type> il,
                const allocator_type& alloc = allocator_type());  // initializer list (6)
@@ -119,7 +207,11 @@ namespace TinySTL {
         allocator_type get_allocator() const noexcept { return alloc; }
 
        private:
+        void copyInit(const vector& x);
         void overflowHandle(size_t minSize = 1);
+        void reallocate(size_type n);
+        T* moveBuffer(size_type n, size_type& bytesMoved, std::false_type);
+        T* moveBuffer(size_type n, size_type& bytesMoved, std::true_type);
 
        private:
         // data stored in [dbegin, dend)
@@ -130,38 +222,43 @@ namespace TinySTL {
 
     };
 
+    // vector only holds plain pointers into its buffer, so with the default
+    // allocator it can be relocated with memcpy when nested in another vector
+    template <typename T, typename Growth>
+    struct is_trivially_relocatable<vector<T, TinySTL::allocator<T>, Growth>> : std::true_type {};
+
     // Non-member function overloads
-    template <class T, class Alloc>
-    void swap(vector<T, Alloc>& lhs, vector<T, Alloc>& rhs);
-
-    template <typename T, typename Alloc>
-    bool operator == (const vector<T, Alloc>& lhs, const vector<T, Alloc>& rhs);
-    template <typename T, typename Alloc>
-    bool operator != (const vector<T, Alloc>& lhs, const vector<T, Alloc>& rhs);
-    template <typename T, typename Alloc>
-    bool operator <  (const vector<T, Alloc>& lhs, const vector<T, Alloc>& rhs);
-    template <typename T, typename Alloc>
-    bool operator <= (const vector<T, Alloc>& lhs, const vector<T, Alloc>& rhs);
-    template <typename T, typename Alloc>
-    bool operator >  (const vector<T, Alloc>& lhs, const vector<T, Alloc>& rhs);
-    template <typename T, typename Alloc>
-    bool operator >= (const vector<T, Alloc>& lhs, const vector<T, Alloc>& rhs);
+    template <typename T, typename Alloc, typename Growth>
+    void swap(vector<T, Alloc, Growth>& lhs, vector<T, Alloc, Growth>& rhs);
+
+    template <typename T, typename Alloc, typename Growth>
+    bool operator == (const vector<T, Alloc, Growth>& lhs, const vector<T, Alloc, Growth>& rhs);
+    template <typename T, typename Alloc, typename Growth>
+    bool operator != (const vector<T, Alloc, Growth>& lhs, const vector<T, Alloc, Growth>& rhs);
+    template <typename T, typename Alloc, typename Growth>
+    bool operator <  (const vector<T, Alloc, Growth>& lhs, const vector<T, Alloc, Growth>& rhs);
+    template <typename T, typename Alloc, typename Growth>
+    bool operator <= (const vector<T, Alloc, Growth>& lhs, const vector<T, Alloc, Growth>& rhs);
+    template <typename T, typename Alloc, typename Growth>
+    bool operator >  (const vector<T, Alloc, Growth>& lhs, const vector<T, Alloc, Growth>& rhs);
+    template <typename T, typename Alloc, typename Growth>
+    bool operator >= (const vector<T, Alloc, Growth>& lhs, const vector<T, Alloc, Growth>& rhs);
 
 }  // namespace TinySTL
 
 
 namespace TinySTL {
 
-    template <typename T, typename Alloc>
-    vector<T, Alloc>::vector(const allocator_type& alloc_)
+    template <typename T, typename Alloc, typename Growth>
+    vector<T, Alloc, Growth>::vector(const allocator_type& alloc_)
         : dbegin(nullptr),
           dend(nullptr),
           endOfStorage(nullptr),
           alloc(alloc_) {
     }
 
-    template <typename T, typename Alloc>
-    vector<T, Alloc>::vector(size_type n) {
+    template <typename T, typename Alloc, typename Growth>
+    vector<T, Alloc, Growth>::vector(size_type n) {
         alloc  = allocator_type();
         if (n == 0) {
             dbegin = nullptr;
@@ -173,8 +270,8 @@ namespace TinySTL {
         endOfStorage = dend;
     }
 
-    template <typename T, typename Alloc>
-    vector<T, Alloc>::vector(size_type n, const value_type& val, const allocator_type& alloc_)
+    template <typename T, typename Alloc, typename Growth>
+    vector<T, Alloc, Growth>::vector(size_type n, const value_type& val, const allocator_type& alloc_)
         : alloc(alloc_) {
         if (n == 0) {
             dbegin = nullptr;
@@ -186,9 +283,9 @@ namespace TinySTL {
         endOfStorage = dend;
     }
 
-    template <typename T, typename Alloc>
+    template <typename T, typename Alloc, typename Growth>
     template <typename InputIterator, typename >
-    vector<T, Alloc>::vector(InputIterator first, InputIterator last, const allocator_type& alloc_)
+    vector<T, Alloc, Growth>::vector(InputIterator first, InputIterator last, const allocator_type& alloc_)
         : alloc(alloc_) {
         difference_type n = last - first;
         if (n == 0) {
@@ -201,9 +298,20 @@ namespace TinySTL {
         endOfStorage = dend;
     }
 
-    template <typename T, typename Alloc>
-    vector<T, Alloc>::vector(const vector& x, const allocator_type& alloc_)
+    template <typename T, typename Alloc, typename Growth>
+    vector<T, Alloc, Growth>::vector(const vector& x)
+        : alloc(x.alloc) {
+        copyInit(x);
+    }
+
+    template <typename T, typename Alloc, typename Growth>
+    vector<T, Alloc, Growth>::vector(const vector& x, const allocator_type& alloc_)
         : alloc(alloc_) {
+        copyInit(x);
+    }
+
+    template <typename T, typename Alloc, typename Growth>
+    void vector<T, Alloc, Growth>::copyInit(const vector& x) {
         difference_type allocSize = x.endOfStorage - x.dbegin;
         if (allocSize == 0) {
             dbegin = nullptr;
@@ -215,20 +323,47 @@ namespace TinySTL {
         endOfStorage = dbegin + allocSize;
     }
 
-    template <typename T, typename Alloc>
-    vector<T, Alloc>::vector(vector&& x, const allocator_type& alloc_)
-        : alloc(alloc_) {
-        dbegin       = x.dbegin;
-        dend         = x.dbegin;
-        endOfStorage = x.endOfStorage;
-        // for save deallocate
-        dbegin       = nullptr;
-        dend         = nullptr;
-        endOfStorage = nullptr;
+    template <typename T, typename Alloc, typename Growth>
+    vector<T, Alloc, Growth>::vector(vector&& x) noexcept
+        : dbegin(x.dbegin),
+          dend(x.dend),
+          endOfStorage(x.endOfStorage),
+          alloc(x.alloc) {
+        // x gives up its buffer so that its destructor is a no-op
+        x.dbegin = x.dend = x.endOfStorage = nullptr;
+    }
+
+    template <typename T, typename Alloc, typename Growth>
+    vector<T, Alloc, Growth>::vector(vector&& x, const allocator_type& alloc_)
+        : dbegin(x.dbegin),
+          dend(x.dend),
+          endOfStorage(x.endOfStorage),
+          alloc(alloc_) {
+        if (alloc == x.alloc) {
+            x.dbegin = x.dend = x.endOfStorage = nullptr;
+            return;
+        }
+        // x's buffer belongs to another allocator (e.g. a different arena):
+        // it must be freed through x, so move the elements out of it instead
+        size_type n = x.dend - x.dbegin;
+        if (n == 0) {
+            dbegin = nullptr;
+        } else {
+            dbegin = alloc.allocate(n);
+            try {
+                TinySTL::uninitialized_relocate_n(x.dbegin, n, dbegin);
+            } catch (...) {
+                alloc.deallocate(dbegin, n);
+                throw;
+            }
+        }
+        dend         = dbegin + n;
+        endOfStorage = dend;
+        x.dend       = x.dbegin;
     }
 
-    template<typename T, typename Alloc>
-    inline vector<T, Alloc>::vector(std::initializer_list<value_type> il, const allocator_type & alloc_)
+    template<typename T, typename Alloc, typename Growth>
+    inline vector<T, Alloc, Growth>::vector(std::initializer_list<value_type> il, const allocator_type & alloc_)
         : alloc(alloc_) {
         size_type allocSize = il.size();
         if (allocSize == 0) {
@@ -241,19 +376,19 @@ namespace TinySTL {
         endOfStorage = dend;
     }
 
-    template <typename T, typename Alloc>
-    vector<T, Alloc>::~vector() {
+    template <typename T, typename Alloc, typename Growth>
+    vector<T, Alloc, Growth>::~vector() {
         clear();
     }
 
-    template <typename T, typename Alloc>
-    vector<T, Alloc>& vector<T, Alloc>::operator=(const vector& x) {
+    template <typename T, typename Alloc, typename Growth>
+    vector<T, Alloc, Growth>& vector<T, Alloc, Growth>::operator=(const vector& x) {
         if (&x != this) {
             if (dbegin != nullptr) {
                 for (T* p = dbegin; p != dend; ++p) {
                     alloc.destroy(p);
                 }
-                alloc.deallocate(dbegin, dend - dbegin);
+                alloc.deallocate(dbegin, capacity());
             }
             alloc                     = x.alloc;
             difference_type allocSize = x.endOfStorage - x.dbegin;
@@ -269,8 +404,8 @@ namespace TinySTL {
         return *this;
     }
 
-    template <typename T, typename Alloc>
-    void vector<T, Alloc>::resize(size_type n) {
+    template <typename T, typename Alloc, typename Growth>
+    void vector<T, Alloc, Growth>::resize(size_type n) {
         size_type currentSize = size();
         size_type maxSize     = capacity();
         if (n <= currentSize) {
@@ -282,22 +417,14 @@ namespace TinySTL {
             TinySTL::uninitialized_fill(dend, dbegin + n, value_type());
             dend = dbegin + n;
         } else {
-            T* oldBegin = dbegin;
-            T* oldEnd   = dend;
-            dbegin      = alloc.allocate(n);
-            TinySTL::uninitialized_copy_n(oldBegin, currentSize, dbegin);
-            TinySTL::uninitialized_fill(dbegin + currentSize, dbegin + n, value_type());
-            dend         = dbegin + n;
-            endOfStorage = dend;
-            for (T* p = oldBegin; p != oldEnd; ++p) {
-                alloc.destroy(p);
-            }
-            alloc.deallocate(oldBegin, maxSize);
+            reserve(n);
+            TinySTL::uninitialized_fill(dend, dbegin + n, value_type());
+            dend = dbegin + n;
         }
     }
 
-    template <typename T, typename Alloc>
-    void vector<T, Alloc>::resize(size_type n, const value_type& val) {
+    template <typename T, typename Alloc, typename Growth>
+    void vector<T, Alloc, Growth>::resize(size_type n, const value_type& val) {
         size_type currentSize = size();
         size_type maxSize     = capacity();
         if (n <= currentSize) {
@@ -309,66 +436,90 @@ namespace TinySTL {
             TinySTL::uninitialized_fill(dend, dbegin + n, val);
             dend = dbegin + n;
         } else {
-            T* oldBegin = dbegin;
-            T* oldEnd   = dend;
-            dbegin      = alloc.allocate(n);
-            TinySTL::uninitialized_copy_n(oldBegin, currentSize, dbegin);
-            TinySTL::uninitialized_fill(dbegin + currentSize, dbegin + n, val);
-            dend         = dbegin + n;
-            endOfStorage = dend;
-            for (T* p = oldBegin; p != oldEnd; ++p) {
-                alloc.destroy(p);
-            }
-            alloc.deallocate(oldBegin, maxSize);
+            reserve(n);
+            TinySTL::uninitialized_fill(dend, dbegin + n, val);
+            dend = dbegin + n;
+        }
+    }
+
+    template <typename T, typename Alloc, typename Growth>
+    void vector<T, Alloc, Growth>::reserve(size_type n) {
+        if (n > capacity()) {
+            reallocate(n);
         }
     }
 
-    template <typename T, typename Alloc>
-    void vector<T, Alloc>::reserve(size_type n) {
+    template <typename T, typename Alloc, typename Growth>
+    void vector<T, Alloc, Growth>::shrink_to_fit() {
+        if (capacity() > size()) {
+            reallocate(size());
+        }
+    }
+
+    template <typename T, typename Alloc, typename Growth>
+    void vector<T, Alloc, Growth>::reallocate(size_type n) {
+        // move the elements into a buffer of exactly n slots (n >= size())
         size_type currentSize = size();
         size_type maxSize     = capacity();
-        if (n > maxSize) {
-            T* oldBegin = dbegin;
-            T* oldEnd   = dend;
-            dbegin      = alloc.allocate(n);
-            if (currentSize > 0) {
-                TinySTL::uninitialized_copy_n(oldBegin, currentSize, dbegin);
-            }
-            dend         = dbegin + currentSize;
-            endOfStorage = dbegin + n;
-            if (currentSize > 0) {
-                for (T* p = oldBegin; p != oldEnd; ++p) {
-                    alloc.destroy(p);
-                }
-                alloc.deallocate(oldBegin, maxSize);
-            }
+        T* newBegin = nullptr;
+        size_type bytesMoved = 0;
+        if (dbegin == nullptr) {
+            newBegin = alloc.allocate(n);
+        } else if (n == 0) {
+            alloc.deallocate(dbegin, maxSize);
+        } else {
+            // allocators that can resize a buffer in place (mremap) are used
+            // for trivially relocatable elements
+            newBegin = moveBuffer(n, bytesMoved, std::integral_constant<bool,
+                TinySTL::is_trivially_relocatable<T>::value &&
+                TinySTL::allocator_has_reallocate<Alloc>::value>());
         }
+        dbegin       = newBegin;
+        dend         = dbegin + currentSize;
+        endOfStorage = dbegin + n;
+        Growth::onReallocate(maxSize * sizeof(T), n * sizeof(T), bytesMoved);
     }
 
-    template <typename T, typename Alloc>
-    void vector<T, Alloc>::shrink_to_fit() {
-        return;
+    template <typename T, typename Alloc, typename Growth>
+    T* vector<T, Alloc, Growth>::moveBuffer(size_type n, size_type& bytesMoved, std::false_type) {
+        // relocate instead of copy + destroy: trivially relocatable elements
+        // are memcpy'd, the rest are moved when that can't throw
+        T* newBegin = alloc.allocate(n);
+        try {
+            TinySTL::uninitialized_relocate_n(dbegin, size(), newBegin);
+        } catch (...) {
+            alloc.deallocate(newBegin, n);
+            throw;
+        }
+        alloc.deallocate(dbegin, capacity());
+        bytesMoved = size() * sizeof(T);
+        return newBegin;
+    }
+
+    template <typename T, typename Alloc, typename Growth>
+    T* vector<T, Alloc, Growth>::moveBuffer(size_type n, size_type& bytesMoved, std::true_type) {
+        return alloc.reallocate(dbegin, capacity(), n, &bytesMoved);
     }
 
-    template <typename T, typename Alloc>
-    typename vector<T, Alloc>::reference vector<T, Alloc>::at(size_type n) {
+    template <typename T, typename Alloc, typename Growth>
+    typename vector<T, Alloc, Growth>::reference vector<T, Alloc, Growth>::at(size_type n) {
         if (n >= size()) {
             throw std::out_of_range("index is out of range");
         }
         return dbegin[n];
     }
 
-    template <typename T, typename Alloc>
-    typename vector<T, Alloc>::const_reference vector<T, Alloc>::at(size_type n) const {
+    template <typename T, typename Alloc, typename Growth>
+    typename vector<T, Alloc, Growth>::const_reference vector<T, Alloc, Growth>::at(size_type n) const {
         if (n >= size()) {
             throw std::out_of_range("index is out of range");
         }
         return dbegin[n];
     }
 
-    template <typename T, typename Alloc>
+    template <typename T, typename Alloc, typename Growth>
     template <class InputIterator, typename >
-    void vector<T, Alloc>::assign(InputIterator first, InputIterator last) {
+    void vector<T, Alloc, Growth>::assign(InputIterator first, InputIterator last) {
         size_type n = last - first;
         if (n > capacity()) {
             overflowHandle(n);
@@ -380,8 +531,8 @@ namespace TinySTL {
         dend = dbegin + n;
     }
 
-    template <typename T, typename Alloc>
-    void vector<T, Alloc>::assign(size_type n, const value_type& val) {
+    template <typename T, typename Alloc, typename Growth>
+    void vector<T, Alloc, Growth>::assign(size_type n, const value_type& val) {
         if (n > capacity()) {
             overflowHandle(n);
         }
@@ -392,8 +543,8 @@ namespace TinySTL {
         dend = dbegin + n;
     }
 
-    template <typename T, typename Alloc>
-    void vector<T, Alloc>::assign(std::initializer_list<value_type> il) {
+    template <typename T, typename Alloc, typename Growth>
+    void vector<T, Alloc, Growth>::assign(std::initializer_list<value_type> il) {
         size_type n = il.size();
         if (n > capacity()) {
             overflowHandle(n);
@@ -405,26 +556,30 @@ namespace TinySTL {
         dend = dbegin + n;
     }
 
-    template <typename T, typename Alloc>
-    void vector<T, Alloc>::push_back(const value_type& val) {
+    template <typename T, typename Alloc, typename Growth>
+    void vector<T, Alloc, Growth>::push_back(const value_type& val) {
         if (dend == endOfStorage) {
+            // val may live in the buffer that is about to be relocated
+            value_type tmp(val);
             overflowHandle();
+            alloc.construct(dend, std::move(tmp));
+        } else {
+            alloc.construct(dend, val);
         }
-        *dend = val;
         dend++;
     }
 
-    template <typename T, typename Alloc>
-    void vector<T, Alloc>::push_back(value_type&& val) {
+    template <typename T, typename Alloc, typename Growth>
+    void vector<T, Alloc, Growth>::push_back(value_type&& val) {
         if (dend == endOfStorage) {
             overflowHandle();
         }
-        *dend = std::move(val);
+        alloc.construct(dend, std::move(val));
         dend++;
     }
 
-    template <typename T, typename Alloc>
-    void vector<T, Alloc>::pop_back() {
+    template <typename T, typename Alloc, typename Growth>
+    void vector<T, Alloc, Growth>::pop_back() {
         if (size() == 0) {
             return;
         }
@@ -432,15 +587,15 @@ namespace TinySTL {
         alloc.destroy(dend);
     }
 
-    template <typename T, typename Alloc>
-    typename vector<T, Alloc>::iterator
-    vector<T, Alloc>::insert(const_iterator position, const value_type& val) {
+    template <typename T, typename Alloc, typename Growth>
+    typename vector<T, Alloc, Growth>::iterator
+    vector<T, Alloc, Growth>::insert(const_iterator position, const value_type& val) {
         return insert(position, 1, val);
     }
 
-    template <typename T, typename Alloc>
-    typename vector<T, Alloc>::iterator
-    vector<T, Alloc>::insert(const_iterator position, size_type n, const value_type& val) {
+    template <typename T, typename Alloc, typename Growth>
+    typename vector<T, Alloc, Growth>::iterator
+    vector<T, Alloc, Growth>::insert(const_iterator position, size_type n, const value_type& val) {
         size_type currentSize = size();
         size_type maxSize     = capacity();
         size_type pos         = position - begin();
@@ -457,10 +612,10 @@ namespace TinySTL {
         return dbegin + pos + n - 1;
     }
 
-    template <typename T, typename Alloc>
+    template <typename T, typename Alloc, typename Growth>
     template <typename InputIterator, typename >
-    typename vector<T, Alloc>::iterator
-    vector<T, Alloc>::insert(const_iterator position, InputIterator first, InputIterator last) {
+    typename vector<T, Alloc, Growth>::iterator
+    vector<T, Alloc, Growth>::insert(const_iterator position, InputIterator first, InputIterator last) {
         size_type currentSize = size();
         size_type maxSize     = capacity();
         size_type pos         = position - begin();
@@ -476,9 +631,9 @@ namespace TinySTL {
         return dbegin + pos + n - 1;
     }
 
-    template <typename T, typename Alloc>
-    typename vector<T, Alloc>::iterator
-    vector<T, Alloc>::insert(const_iterator position, value_type&& val) {
+    template <typename T, typename Alloc, typename Growth>
+    typename vector<T, Alloc, Growth>::iterator
+    vector<T, Alloc, Growth>::insert(const_iterator position, value_type&& val) {
         size_type currentSize = size();
         size_type maxSize     = capacity();
         size_type pos         = position - begin();
@@ -493,9 +648,9 @@ namespace TinySTL {
         return dbegin + pos;
     }
 
-    template <typename T, typename Alloc>
-    typename vector<T, Alloc>::iterator
-    vector<T, Alloc>::insert(const_iterator position, std::initializer_list<value_type> il) {
+    template <typename T, typename Alloc, typename Growth>
+    typename vector<T, Alloc, Growth>::iterator
+    vector<T, Alloc, Growth>::insert(const_iterator position, std::initializer_list<value_type> il) {
         size_type currentSize = size();
         size_type maxSize     = capacity();
         size_type pos         = position - begin();
@@ -511,9 +666,9 @@ namespace TinySTL {
         return dbegin + pos + n - 1;
     }
 
-    template <typename T, typename Alloc>
-    typename vector<T, Alloc>::iterator
-    vector<T, Alloc>::erase(const_iterator position) {
+    template <typename T, typename Alloc, typename Growth>
+    typename vector<T, Alloc, Growth>::iterator
+    vector<T, Alloc, Growth>::erase(const_iterator position) {
         size_type currentSize = size();
         size_type pos         = position - begin();
         if (currentSize == 0) {
@@ -527,9 +682,9 @@ namespace TinySTL {
         return dbegin + pos;
     }
 
-    template <typename T, typename Alloc>
-    typename vector<T, Alloc>::iterator
-    vector<T, Alloc>::erase(const_iterator first, const_iterator last) {
+    template <typename T, typename Alloc, typename Growth>
+    typename vector<T, Alloc, Growth>::iterator
+    vector<T, Alloc, Growth>::erase(const_iterator first, const_iterator last) {
         assert(first >= dbegin);
         assert(first <= last);
         assert(last <= dend);
@@ -547,29 +702,29 @@ namespace TinySTL {
         return dbegin + (first - dbegin);
     }
 
-    template <typename T, typename Alloc>
-    void vector<T, Alloc>::swap(vector& x) {
+    template <typename T, typename Alloc, typename Growth>
+    void vector<T, Alloc, Growth>::swap(vector& x) {
         std::swap(alloc, x.alloc);
         std::swap(dbegin, x.dbegin);
         std::swap(dend, x.dend);
         std::swap(endOfStorage, x.endOfStorage);
     }
 
-    template <typename T, typename Alloc>
-    void vector<T, Alloc>::clear() {
+    template <typename T, typename Alloc, typename Growth>
+    void vector<T, Alloc, Growth>::clear() {
         if (dbegin != nullptr) {
             for (T* p = dbegin; p != dend; ++p) {
                 alloc.destroy(p);
             }
-            alloc.deallocate(dbegin, dend - dbegin);
+            alloc.deallocate(dbegin, capacity());
         }
         dbegin = dend = endOfStorage = nullptr;
     }
 
-    template <typename T, typename Alloc>
+    template <typename T, typename Alloc, typename Growth>
     template <class... Args>
-    typename vector<T, Alloc>::iterator
-    vector<T, Alloc>::emplace(const_iterator position, Args&&... args) {
+    typename vector<T, Alloc, Growth>::iterator
+    vector<T, Alloc, Growth>::emplace(const_iterator position, Args&&... args) {
         size_type currentSize = size();
         size_type maxSize     = capacity();
         size_type pos         = position - begin();
@@ -584,9 +739,9 @@ namespace TinySTL {
         return dbegin + pos;
     }
 
-    template <typename T, typename Alloc>
+    template <typename T, typename Alloc, typename Growth>
     template <class... Args>
-    void vector<T, Alloc>::emplace_back(Args&&... args) {
+    void vector<T, Alloc, Growth>::emplace_back(Args&&... args) {
         if (dend == endOfStorage) {
             overflowHandle();
         }
@@ -594,27 +749,19 @@ namespace TinySTL {
         dend++;
     }
 
-    template <typename T, typename Alloc>
-    void vector<T, Alloc>::overflowHandle(size_t minSize) {
-        size_type currentSize = size();
-        size_type allocSize   = 2 * currentSize;
-        if (allocSize == 0) {
-            allocSize = 1;
-        }
-        if (allocSize < minSize) {
-            allocSize = minSize;
-        }
-        // std::cout << "alloc size: " << allocSize << std::endl;
+    template <typename T, typename Alloc, typename Growth>
+    void vector<T, Alloc, Growth>::overflowHandle(size_t minSize) {
+        size_type allocSize = Growth::grow(capacity(), minSize, sizeof(T));
         reserve(allocSize);
     }
 
-    template <class T, class Alloc>
-    void swap(vector<T, Alloc>& lhs, vector<T, Alloc>& rhs) {
+    template <typename T, typename Alloc, typename Growth>
+    void swap(vector<T, Alloc, Growth>& lhs, vector<T, Alloc, Growth>& rhs) {
         lhs.swap(rhs);
     }
 
-    template <typename T, typename Alloc>
-    bool operator==(const vector<T, Alloc>& lhs, const vector<T, Alloc>& rhs) {
+    template <typename T, typename Alloc, typename Growth>
+    bool operator==(const vector<T, Alloc, Growth>& lhs, const vector<T, Alloc, Growth>& rhs) {
         if (lhs.size() == rhs.size()) {
             for (size_t i = 0; i < lhs.size(); ++i) {
                 if (lhs[i] != rhs[i])
@@ -625,13 +772,13 @@ namespace TinySTL {
             return false;
     }
 
-    template <typename T, typename Alloc>
-    bool operator!=(const vector<T, Alloc>& lhs, const vector<T, Alloc>& rhs) {
+    template <typename T, typename Alloc, typename Growth>
+    bool operator!=(const vector<T, Alloc, Growth>& lhs, const vector<T, Alloc, Growth>& rhs) {
         return !(lhs == rhs);
     }
 
-    template <typename T, typename Alloc>
-    bool operator<(const vector<T, Alloc>& lhs, const vector<T, Alloc>& rhs) {
+    template <typename T, typename Alloc, typename Growth>
+    bool operator<(const vector<T, Alloc, Growth>& lhs, const vector<T, Alloc, Growth>& rhs) {
         size_t length = lhs.size() < rhs.size() ? lhs.size() : rhs.size();
         for (size_t i = 0; i < length; ++i) {
             if (lhs[i] < rhs[i])
@@ -642,18 +789,18 @@ namespace TinySTL {
         return lhs.size() < rhs.size();
     }
 
-    template <typename T, typename Alloc>
-    bool operator<=(const vector<T, Alloc>& lhs, const vector<T, Alloc>& rhs) {
+    template <typename T, typename Alloc, typename Growth>
+    bool operator<=(const vector<T, Alloc, Growth>& lhs, const vector<T, Alloc, Growth>& rhs) {
         return lhs < rhs || lhs == rhs;
     }
 
-    template <typename T, typename Alloc>
-    bool operator>(const vector<T, Alloc>& lhs, const vector<T, Alloc>& rhs) {
+    template <typename T, typename Alloc, typename Growth>
+    bool operator>(const vector<T, Alloc, Growth>& lhs, const vector<T, Alloc, Growth>& rhs) {
         return !(lhs < rhs || lhs == rhs);
     }
 
-    template <typename T, typename Alloc>
-    bool operator>=(const vector<T, Alloc>& lhs, const vector<T, Alloc>& rhs) {
+    template <typename T, typename Alloc, typename Growth>
+    bool operator>=(const vector<T, Alloc, Growth>& lhs, const vector<T, Alloc, Growth>& rhs) {
         return !(lhs < rhs);
     }
 
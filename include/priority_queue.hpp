@@ -3,11 +3,22 @@
 
 #include "Vector.hpp"
 #include "Iterator.hpp"
+#include "Allocator.hpp"
+
+#include <functional>
+#include <utility>
 
 namespace TinySTL {
 
-    template <typename T, typename Container = TinySTL::vector<T>, typename Compare = std::less<typename Container::value_type>>
+    // Arity children per node (a binary heap by default). For Arity > 2
+    // the heap keeps Arity - 1 padding slots in front of the root, so the
+    // children of every node start at a multiple of Arity: with a buffer
+    // aligned to Arity * sizeof(T) bytes (see aligned_priority_queue) each
+    // sibling group is one cache line and a siftDown level costs one miss.
+    template <typename T, typename Container = TinySTL::vector<T>, typename Compare = std::less<typename Container::value_type>, std::size_t Arity = 2>
     class priority_queue {
+        static_assert(Arity >= 2, "a heap node needs at least two children");
+
     public:
         using value_type = T;
         using container_type = Container;
@@ -22,108 +33,213 @@ namespace TinySTL {
         priority_queue(InputIterator first, InputIterator last, const Compare& comp = Compare()) 
             : compare(comp), heap()
         {
-            heap.assign(first, last);
+            if (first != last) {
+                heap.assign(Offset, *first);
+                for (; first != last; ++first) {
+                    heap.push_back(*first);
+                }
+            }
             make_heap();
         }
 
-        bool empty() const { return heap.empty(); }
+        bool empty() const { return size() == 0; }
 
-        size_type size() const { return heap.size(); }
+        size_type size() const { return heap.size() > Offset ? heap.size() - Offset : 0; }
 
-        const_reference top() const { return heap[0]; }
+        const_reference top() const { return heap[Offset]; }
 
         void pop() {
-            heap[0] = heap[heap.size() - 1];
+            value_type last = std::move(heap[heap.size() - 1]);
             heap.pop_back();
-            siftDown(0, heap.size() - 1);
+            if (!empty()) {
+                siftDown(0, std::move(last));
+            }
         }
 
         void push(const value_type& val) {
+            if (heap.size() < Offset) {
+                heap.assign(Offset, val);
+            }
             heap.push_back(val);
-            siftUp(heap.size() - 1);
+            siftUp(size() - 1, std::move(node(size() - 1)));
         }
 
         void push(value_type&& val) {
-            heap.push_back(val);
-            siftUp(heap.size() - 1);
+            if (heap.size() < Offset) {
+                heap.assign(Offset, val);
+            }
+            heap.push_back(std::move(val));
+            siftUp(size() - 1, std::move(node(size() - 1)));
         }
 
         template <typename... Args> 
         void emplace(Args&&... args) {
+            if (heap.size() < Offset) {
+                push(value_type(std::forward<Args>(args)...));
+                return;
+            }
             heap.emplace_back(std::forward<Args>(args)...);
-            siftUp(heap.size() - 1);
+            siftUp(size() - 1, std::move(node(size() - 1)));
+        }
+
+        // Appends [first, last) and restores the heap by sifting up each
+        // new element, switching to one Floyd rebuild of the whole heap
+        // when the sift-ups grow more expensive than that.
+        template <typename InputIterator>
+        void push_range(InputIterator first, InputIterator last) {
+            size_type old = size();
+            for (; first != last; ++first) {
+                if (heap.size() < Offset) {
+                    heap.assign(Offset, *first);
+                }
+                heap.push_back(*first);
+            }
+            heapifyAppended(old);
+        }
+
+        // moves every element of x into this queue in O(size() + x.size())
+        // and leaves x empty
+        void merge(priority_queue& x) {
+            if (&x == this) {
+                return;
+            }
+            size_type old = size();
+            heap.reserve(Offset + old + x.size());
+            for (size_type i = 0; i < x.size(); i++) {
+                if (heap.size() < Offset) {
+                    heap.assign(Offset, x.node(i));
+                }
+                heap.push_back(std::move(x.node(i)));
+            }
+            x.clear();
+            heapifyAppended(old);
+        }
+
+        // moves the (at most) k top elements to out in order; returns the
+        // end of the output
+        template <typename OutputIterator>
+        OutputIterator pop_n(size_type k, OutputIterator out) {
+            for (; k > 0 && !empty(); --k) {
+                *out = std::move(node(0));
+                ++out;
+                pop();
+            }
+            return out;
         }
 
         void clear() { heap.clear(); }
 
         void increaseKey(const T& k, const T& newKey) {
-            int i;
-            for (i = 0; i < heap.size(); i++) {
-                if (heap[i] == k) {
-                    heap[i] = newKey;
+            size_type i;
+            for (i = 0; i < size(); i++) {
+                if (node(i) == k) {
                     break;
                 }
             }
-            siftDown(i, heap.size() - 1);
+            if (i < size()) {
+                siftDown(i, newKey);
+            }
         }
 
         void decreaseKey(const T& k, const T& newKey) {
-            int i;
-            for (i = 0; i < heap.size(); i++) {
-                if (heap[i] == k) {
-                    heap[i] = newKey;
+            size_type i;
+            for (i = 0; i < size(); i++) {
+                if (node(i) == k) {
                     break;
                 }
             }
-            siftUp(i);
+            if (i < size()) {
+                siftUp(i, newKey);
+            }
         }
 
         const_reference find(const T& k) {
-            int i;
-            for (i = 0; i < heap.size(); i++) {
-                if (heap[i] == k) {
-                    return heap[i];
+            size_type i;
+            for (i = 0; i < size(); i++) {
+                if (node(i) == k) {
+                    return node(i);
                 }
             }
             return T();
         }
 
         void swap(priority_queue& x) noexcept {
-            heap.swap(x);
+            std::swap(compare, x.compare);
+            heap.swap(x.heap);
         }
 
     private:
-        void siftDown(size_type start, size_type end) {
-            size_type p = start;
-            while (p < end) {
-                size_type k = 2 * p + 1;
-                if (k >= heap.size())
-                    break;
-                if (k + 1 < heap.size() && compare(heap[k + 1], heap[k]))
-                    k++;
-                if (compare(heap[p], heap[k]))
+        // padding slots in front of the root
+        static const size_type Offset = Arity > 2 ? Arity - 1 : 0;
+
+        reference node(size_type i) { return heap[i + Offset]; }
+
+        // Bottom-up sift: val goes into the subtree whose root is the hole
+        // at start. The hole first sinks to a leaf along the smallest
+        // children, moving each one up a level without comparing it to val,
+        // then val climbs back from the leaf. A popped value comes from the
+        // bottom of the heap and belongs near it, so the climb is short and
+        // this takes about half the comparisons of the textbook sift, with
+        // one move instead of a swap per level.
+        void siftDown(size_type start, value_type val) {
+            size_type hole = start;
+            size_type n = size();
+            for (;;) {
+                size_type k = Arity * hole + 1;
+                if (k >= n)
                     break;
-                std::swap(heap[k], heap[p]);
-                p = k;
+                size_type last = k + Arity < n ? k + Arity : n;
+                for (size_type c = k + 1; c < last; c++) {
+                    if (compare(node(c), node(k)))
+                        k = c;
+                }
+                node(hole) = std::move(node(k));
+                hole = k;
             }
+            siftUp(hole, std::move(val), start);
         }
 
-        void siftUp(size_type start) {
-            int p = start;
-            while (p > 0) {
-                int k = (p - 1) / 2;
-                if (compare(heap[k], heap[p]))
+        // moves the parents of the hole down until val fits, never above
+        // top; returns the number of levels val climbed
+        size_type siftUp(size_type hole, value_type val, size_type top = 0) {
+            size_type levels = 0;
+            while (hole > top) {
+                size_type k = (hole - 1) / Arity;
+                if (!compare(val, node(k)))
                     break;
-                std::swap(heap[k], heap[p]);
-                p = k;
+                node(hole) = std::move(node(k));
+                hole = k;
+                levels++;
+            }
+            node(hole) = std::move(val);
+            return levels;
+        }
+
+        // Elements [old, size()) were appended unordered. A sift-up costs
+        // one move per level it climbs: up to the depth of the heap, but
+        // only a level or two for typical keys. Floyd's rebuild touches
+        // every element and costs about as much as four levels each. So
+        // sift up while the levels climbed stay within that, and rebuild
+        // once they exceed it; either way the batch takes O(size()).
+        void heapifyAppended(size_type old) {
+            size_type n = size();
+            size_type budget = 4 * n;
+            for (size_type i = old; i < n; i++) {
+                size_type climbed = siftUp(i, std::move(node(i)));
+                if (climbed > budget) {
+                    make_heap();
+                    return;
+                }
+                budget -= climbed;
             }
         }
 
         void make_heap() {
-            int start = heap.size() / 2;
-            while (start >= 0) {
-                siftDown(start, heap.size() - 1);
-                start--;
+            if (size() < 2)
+                return;
+            size_type start = (size() - 2) / Arity + 1;
+            while (start-- > 0) {
+                siftDown(start, std::move(node(start)));
             }
         }
 
@@ -132,6 +248,184 @@ namespace TinySTL {
         container_type heap; // min heap
     };
 
+    template <typename T, typename Container, typename Compare, std::size_t Arity>
+    const typename priority_queue<T, Container, Compare, Arity>::size_type
+        priority_queue<T, Container, Compare, Arity>::Offset;
+
+    // d-ary heap whose sibling groups fill whole cache lines: pick Arity so
+    // that Arity * sizeof(T) is 64 (e.g. 8 for doubles, 16 for ints).
+    // Elements wider than 32 bytes fall back to a binary heap.
+    template <typename T, std::size_t Arity = (64 / sizeof(T) >= 2 ? 64 / sizeof(T) : 2),
+              typename Compare = std::less<T>>
+    using aligned_priority_queue =
+        priority_queue<T, TinySTL::vector<T, TinySTL::aligned_allocator<T, 64>>, Compare, Arity>;
+
+    // Addressable heap: every element gets a handle that stays valid until
+    // the element is popped or erased. A position index (handle -> heap
+    // slot) makes lookups O(1) and key updates and removal of arbitrary
+    // elements O(log n). Container stores the values by handle; the heap
+    // itself only moves handles around. As in priority_queue, top() is the
+    // smallest element under Compare.
+    template <typename T, typename Container = TinySTL::vector<T>, typename Compare = std::less<typename Container::value_type>>
+    class indexed_priority_queue {
+    public:
+        using value_type = T;
+        using container_type = Container;
+        using reference = typename container_type::reference;
+        using const_reference = typename container_type::const_reference;
+        using size_type = std::size_t;
+        using handle = std::size_t;
+
+        static const handle npos = (handle)-1;
+
+    public:
+        explicit indexed_priority_queue(const Compare& comp = Compare())
+            : compare(comp)
+        { }
+
+        bool empty() const { return heap.empty(); }
+
+        size_type size() const { return heap.size(); }
+
+        // make handles below n usable without reallocation
+        void reserve(size_type n) {
+            data.reserve(n);
+            pos.reserve(n);
+            heap.reserve(n);
+        }
+
+        const_reference top() const { return data[heap[0]]; }
+        handle top_handle() const { return heap[0]; }
+
+        bool contains(handle h) const { return h < pos.size() && pos[h] != npos; }
+        const_reference get(handle h) const { return data[h]; }
+
+        // insert val under a new handle and return the handle
+        handle push(const value_type& val) {
+            // freed handles may have been reused by push(h, val) since
+            while (!freeHandles.empty() && contains(freeHandles.back())) {
+                freeHandles.pop_back();
+            }
+            handle h;
+            if (!freeHandles.empty()) {
+                h = freeHandles.back();
+                freeHandles.pop_back();
+            } else {
+                h = data.size();
+            }
+            push(h, val);
+            return h;
+        }
+
+        // insert val under a handle chosen by the caller (e.g. a vertex id),
+        // which must not be in the queue
+        void push(handle h, const value_type& val) {
+            if (h >= data.size()) {
+                data.resize(h + 1);
+                pos.resize(h + 1, npos);
+            }
+            data[h] = val;
+            pos[h] = heap.size();
+            heap.push_back(h);
+            siftUp(pos[h]);
+        }
+
+        void pop() { erase(heap[0]); }
+
+        // remove the element with handle h wherever it is in the heap
+        void erase(handle h) {
+            size_type i = pos[h];
+            handle last = heap[heap.size() - 1];
+            heap.pop_back();
+            pos[h] = npos;
+            freeHandles.push_back(h);
+            if (i < heap.size()) {
+                heap[i] = last;
+                pos[last] = i;
+                siftUp(i);
+                siftDown(pos[last]);
+            }
+        }
+
+        // newKey must not compare less than the current value
+        void increaseKey(handle h, const value_type& newKey) {
+            data[h] = newKey;
+            siftDown(pos[h]);
+        }
+
+        // newKey must not compare greater than the current value
+        void decreaseKey(handle h, const value_type& newKey) {
+            data[h] = newKey;
+            siftUp(pos[h]);
+        }
+
+        // set a new value and restore the heap in whichever direction
+        void update(handle h, const value_type& val) {
+            data[h] = val;
+            siftUp(pos[h]);
+            siftDown(pos[h]);
+        }
+
+        void clear() {
+            heap.clear();
+            data.clear();
+            pos.clear();
+            freeHandles.clear();
+        }
+
+        void swap(indexed_priority_queue& x) noexcept {
+            std::swap(compare, x.compare);
+            data.swap(x.data);
+            heap.swap(x.heap);
+            pos.swap(x.pos);
+            freeHandles.swap(x.freeHandles);
+        }
+
+    private:
+        void siftUp(size_type i) {
+            handle h = heap[i];
+            while (i > 0) {
+                size_type p = (i - 1) / 2;
+                if (!compare(data[h], data[heap[p]]))
+                    break;
+                heap[i] = heap[p];
+                pos[heap[i]] = i;
+                i = p;
+            }
+            heap[i] = h;
+            pos[h] = i;
+        }
+
+        void siftDown(size_type i) {
+            handle h = heap[i];
+            size_type n = heap.size();
+            for (;;) {
+                size_type k = 2 * i + 1;
+                if (k >= n)
+                    break;
+                if (k + 1 < n && compare(data[heap[k + 1]], data[heap[k]]))
+                    k++;
+                if (!compare(data[heap[k]], data[h]))
+                    break;
+                heap[i] = heap[k];
+                pos[heap[i]] = i;
+                i = k;
+            }
+            heap[i] = h;
+            pos[h] = i;
+        }
+
+    private:
+        Compare compare;
+        container_type data;               // values by handle
+        TinySTL::vector<handle> heap;      // min heap of handles
+        TinySTL::vector<size_type> pos;    // handle -> heap slot, npos if absent
+        TinySTL::vector<handle> freeHandles;
+    };
+
+    template <typename T, typename Container, typename Compare>
+    const typename indexed_priority_queue<T, Container, Compare>::handle
+        indexed_priority_queue<T, Container, Compare>::npos;
 
 } // namespace TinySTL 
 
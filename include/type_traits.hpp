@@ -1,6 +1,8 @@
 #ifndef TYPE_TRAITS_HPP
 #define TYPE_TRAITS_HPP
 
+#include <type_traits>
+
 namespace TinySTL {
 
     // ALIAS TEMPLATE void_t
@@ -44,6 +46,14 @@ namespace TinySTL {
         static constexpr bool value = true;
     };
 
+    // A type is trivially relocatable when moving an object to new storage
+    // and destroying the original is equivalent to a memcpy of its bytes.
+    // Trivially copyable types always are; containers that own their buffer
+    // through plain pointers can opt in by specializing this trait.
+    template <typename T>
+    struct is_trivially_relocatable
+        : std::integral_constant<bool, std::is_trivially_copyable<T>::value> {};
+
 }  // namespace TinySTL
 
 #endif  // TYPE_TRAITS_HPP
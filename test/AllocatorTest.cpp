@@ -0,0 +1,172 @@
+#include <string>
+#include <thread>
+#include "Allocator.hpp"
+#include "Vector.hpp"
+#include "gtest/gtest.h"
+
+TEST(AllocatorTest, FixedPool) {
+    TinySTL::fixed_pool pool(24, 4);
+    EXPECT_EQ((size_t)0, pool.block_size() % alignof(std::max_align_t));
+
+    void* blocks[10];
+    for (int i = 0; i < 10; i++) {
+        blocks[i] = pool.allocate();
+        for (int j = 0; j < i; j++) {
+            EXPECT_NE(blocks[i], blocks[j]);
+        }
+    }
+    // freed blocks are handed out again
+    pool.deallocate(blocks[3]);
+    EXPECT_EQ(blocks[3], pool.allocate());
+    pool.release();
+}
+
+TEST(AllocatorTest, FixedPoolGrowth) {
+    // chunks of 2, 4, 8, 8, 8 blocks, each handed out in address order
+    TinySTL::fixed_pool pool(16, 2, 8);
+    std::size_t size = pool.block_size();
+    char* blocks[30];
+    for (int i = 0; i < 30; i++) {
+        blocks[i] = static_cast<char*>(pool.allocate());
+    }
+    EXPECT_EQ(blocks[2] + 3 * size, blocks[5]);
+    EXPECT_EQ(blocks[6] + 7 * size, blocks[13]);
+    EXPECT_EQ(blocks[14] + 7 * size, blocks[21]);
+    EXPECT_NE(blocks[21] + size, blocks[22]);
+
+    // release starts over with a small chunk
+    pool.release();
+    char* first = static_cast<char*>(pool.allocate());
+    EXPECT_EQ(first + size, pool.allocate());
+    EXPECT_NE(first + 2 * size, pool.allocate());
+
+    pool.add_chunk(100);
+    first = static_cast<char*>(pool.allocate());
+    for (int i = 1; i < 100; i++) {
+        EXPECT_EQ(first + i * size, pool.allocate());
+    }
+}
+
+TEST(AllocatorTest, PoolAllocator) {
+    TinySTL::pool_allocator<double> alloc;
+    double* p = alloc.allocate(1);
+    alloc.construct(p, 1.5);
+    EXPECT_EQ(1.5, *p);
+    alloc.destroy(p);
+    alloc.deallocate(p, 1);
+    EXPECT_EQ(p, alloc.allocate(1));
+    alloc.deallocate(p, 1);
+
+    TinySTL::pool_allocator<double>::rebind<char>::other charAlloc(alloc);
+    EXPECT_TRUE(charAlloc == alloc);
+
+    TinySTL::vector<std::string, TinySTL::pool_allocator<std::string>> vec;
+    for (int i = 0; i < 100; i++) {
+        vec.push_back(std::to_string(i));
+    }
+    for (int i = 0; i < 100; i++) {
+        EXPECT_EQ(std::to_string(i), vec[i]);
+    }
+}
+
+TEST(AllocatorTest, Arena) {
+    TinySTL::monotonic_arena arena(256);
+    TinySTL::arena_allocator<int> alloc(arena);
+
+    int* p = alloc.allocate(10);
+    EXPECT_EQ((size_t)40, arena.bytes_allocated());
+    alloc.deallocate(p, 10);
+    EXPECT_EQ((size_t)0, arena.bytes_allocated());
+    EXPECT_EQ(p, alloc.allocate(10));
+
+    // requests larger than a chunk get a chunk of their own
+    int* big = alloc.allocate(1000);
+    big[999] = 1;
+
+    TinySTL::arena_allocator<char> charAlloc(alloc);
+    EXPECT_TRUE(charAlloc == alloc);
+
+    {
+        TinySTL::vector<int, TinySTL::arena_allocator<int>> vec(alloc);
+        for (int i = 0; i < 1000; i++) {
+            vec.push_back(i);
+        }
+        TinySTL::vector<int, TinySTL::arena_allocator<int>> copy(vec);
+        EXPECT_TRUE(copy.get_allocator() == alloc);
+        for (int i = 0; i < 1000; i++) {
+            EXPECT_EQ(i, copy[i]);
+        }
+    }
+    arena.release();
+    EXPECT_EQ((size_t)0, arena.bytes_allocated());
+}
+
+TEST(AllocatorTest, ArenaMoveAcrossArenas) {
+    TinySTL::monotonic_arena first(256), second(256);
+    TinySTL::arena_allocator<std::string> firstAlloc(first), secondAlloc(second);
+
+    TinySTL::vector<std::string, TinySTL::arena_allocator<std::string>> vec(firstAlloc);
+    for (int i = 0; i < 100; i++) {
+        vec.push_back(std::to_string(i));
+    }
+    std::size_t firstBytes = first.bytes_allocated();
+
+    // same arena: the buffer is stolen
+    const std::string* buffer = vec.begin();
+    TinySTL::vector<std::string, TinySTL::arena_allocator<std::string>> stolen(std::move(vec), firstAlloc);
+    EXPECT_EQ(buffer, stolen.begin());
+    EXPECT_EQ(firstBytes, first.bytes_allocated());
+
+    // another arena: elements are moved into a buffer of its own
+    TinySTL::vector<std::string, TinySTL::arena_allocator<std::string>> moved(std::move(stolen), secondAlloc);
+    EXPECT_TRUE(moved.get_allocator() == secondAlloc);
+    EXPECT_NE(buffer, moved.begin());
+    EXPECT_EQ((size_t)100, moved.size());
+    EXPECT_TRUE(stolen.empty());
+    EXPECT_LT((size_t)0, second.bytes_allocated());
+    for (int i = 0; i < 100; i++) {
+        EXPECT_EQ(std::to_string(i), moved[i]);
+    }
+}
+
+TEST(AllocatorTest, ThreadCache) {
+    TinySTL::thread_cache_allocator<int> alloc;
+    int* p = alloc.allocate(5);
+    alloc.deallocate(p, 5);
+    // same size class, same thread: the cached block comes back
+    EXPECT_EQ(p, alloc.allocate(7));
+    alloc.deallocate(p, 7);
+
+    std::thread workers[4];
+    for (int t = 0; t < 4; t++) {
+        workers[t] = std::thread([t]() {
+            TinySTL::vector<int, TinySTL::thread_cache_allocator<int>> vec;
+            for (int i = 0; i < 10000; i++) {
+                vec.push_back(i * t);
+            }
+            for (int i = 0; i < 10000; i++) {
+                EXPECT_EQ(i * t, vec[i]);
+            }
+        });
+    }
+    for (int t = 0; t < 4; t++) {
+        workers[t].join();
+    }
+}
+
+TEST(AllocatorTest, Aligned) {
+    TinySTL::aligned_allocator<char, 64> alloc;
+    for (size_t n = 1; n < 300; n += 37) {
+        char* p = alloc.allocate(n);
+        EXPECT_EQ((size_t)0, reinterpret_cast<size_t>(p) % 64);
+        p[0] = p[n - 1] = 'x';
+        alloc.deallocate(p, n);
+    }
+
+    TinySTL::vector<double, TinySTL::aligned_allocator<double, 128>> vec;
+    for (int i = 0; i < 1000; i++) {
+        vec.push_back(i);
+        EXPECT_EQ((size_t)0, reinterpret_cast<size_t>(&vec[0]) % 128);
+    }
+    EXPECT_EQ(999.0, vec.back());
+}
@@ -0,0 +1,150 @@
+#include <string>
+#include <thread>
+#include "ConcurrentQueue.hpp"
+#include "Vector.hpp"
+#include "gtest/gtest.h"
+
+TEST(ConcurrentQueueTest, SpscBasic) {
+    TinySTL::spsc_queue<std::string> queue(5);
+    EXPECT_EQ((size_t)8, queue.capacity());
+    EXPECT_TRUE(queue.empty());
+
+    for (int i = 0; i < 8; i++) {
+        EXPECT_TRUE(queue.try_push(std::to_string(i)));
+    }
+    EXPECT_FALSE(queue.try_push("full"));
+    EXPECT_EQ((size_t)8, queue.size_approx());
+
+    std::string s;
+    for (int i = 0; i < 8; i++) {
+        EXPECT_TRUE(queue.try_pop(s));
+        EXPECT_EQ(std::to_string(i), s);
+    }
+    EXPECT_FALSE(queue.try_pop(s));
+
+    // leave items behind for the destructor
+    EXPECT_TRUE(queue.try_emplace(3, 'x'));
+    EXPECT_TRUE(queue.try_emplace("yy"));
+}
+
+TEST(ConcurrentQueueTest, SpscBatch) {
+    TinySTL::spsc_queue<int> queue(16);
+    TinySTL::vector<int> in;
+    for (int i = 0; i < 20; i++) {
+        in.push_back(i);
+    }
+    EXPECT_EQ((size_t)16, queue.push_batch(in.begin(), in.end()));
+    EXPECT_EQ((size_t)0, queue.push_batch(in.begin(), in.end()));
+
+    int out[10];
+    EXPECT_EQ((size_t)10, queue.pop_batch(out, 10));
+    for (int i = 0; i < 10; i++) {
+        EXPECT_EQ(i, out[i]);
+    }
+    EXPECT_EQ((size_t)4, queue.push_batch(in.begin() + 16, in.end()));
+    EXPECT_EQ((size_t)10, queue.pop_batch(out, 10));
+    EXPECT_EQ(10, out[0]);
+    EXPECT_EQ(19, out[9]);
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(ConcurrentQueueTest, SpscThreads) {
+    const long long count = 200000;
+    TinySTL::spsc_queue<long long> queue(1024);
+    std::thread producer([&] {
+        for (long long i = 0; i < count; i++) {
+            while (!queue.try_push(i)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+    long long expected = 0;
+    bool ordered = true;
+    while (expected < count) {
+        long long val;
+        if (queue.try_pop(val)) {
+            ordered = ordered && val == expected;
+            expected++;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    EXPECT_TRUE(ordered);
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(ConcurrentQueueTest, MpmcBasic) {
+    TinySTL::mpmc_queue<std::string> queue(4);
+    EXPECT_EQ((size_t)4, queue.capacity());
+    for (int i = 0; i < 4; i++) {
+        EXPECT_TRUE(queue.try_push(std::to_string(i)));
+    }
+    EXPECT_FALSE(queue.try_push("full"));
+
+    std::string s;
+    EXPECT_TRUE(queue.try_pop(s));
+    EXPECT_EQ("0", s);
+    EXPECT_TRUE(queue.try_emplace(2, 'z'));
+
+    TinySTL::vector<std::string> out(8);
+    EXPECT_EQ((size_t)4, queue.pop_batch(out.begin(), 8));
+    EXPECT_EQ("1", out[0]);
+    EXPECT_EQ("zz", out[3]);
+    EXPECT_FALSE(queue.try_pop(s));
+
+    TinySTL::vector<std::string> in(6, "a");
+    EXPECT_EQ((size_t)4, queue.push_batch(in.begin(), in.end()));
+    EXPECT_EQ((size_t)4, queue.size_approx());
+}
+
+TEST(ConcurrentQueueTest, MpmcThreads) {
+    const int threads = 4;
+    const long long perThread = 50000;
+    TinySTL::mpmc_queue<long long> queue(256);
+    std::atomic<long long> sum(0);
+    std::atomic<long long> popped(0);
+
+    TinySTL::vector<std::thread*> workers;
+    for (int t = 0; t < threads; t++) {
+        workers.push_back(new std::thread([&, t] {
+            long long batch[8];
+            for (long long i = 0; i < perThread; i += 8) {
+                for (int j = 0; j < 8; j++) {
+                    batch[j] = t * perThread + i + j;
+                }
+                long long* first = batch;
+                while (first != batch + 8) {
+                    size_t n = queue.push_batch(first, batch + 8);
+                    if (n == 0) {
+                        std::this_thread::yield();
+                    }
+                    first += n;
+                }
+            }
+        }));
+        workers.push_back(new std::thread([&] {
+            long long local = 0;
+            long long out[16];
+            while (popped.load() < threads * perThread) {
+                size_t n = queue.pop_batch(out, 16);
+                if (n == 0) {
+                    std::this_thread::yield();
+                }
+                for (size_t j = 0; j < n; j++) {
+                    local += out[j];
+                }
+                popped += n;
+            }
+            sum += local;
+        }));
+    }
+    for (size_t i = 0; i < workers.size(); i++) {
+        workers[i]->join();
+        delete workers[i];
+    }
+    long long total = threads * perThread;
+    EXPECT_EQ(total, popped.load());
+    EXPECT_EQ(total * (total - 1) / 2, sum.load());
+    EXPECT_TRUE(queue.empty());
+}
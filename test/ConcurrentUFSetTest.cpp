@@ -0,0 +1,54 @@
+#include <cstdlib>
+#include <utility>
+#include "ConcurrentUFSet.hpp"
+#include "UFSet.hpp"
+#include "Vector.hpp"
+#include "gtest/gtest.h"
+
+TEST(ConcurrentUFSetTest, test1) {
+    TinySTL::ConcurrentUFSet sets(10);
+
+    EXPECT_FALSE(sets.inSame(0, 1));
+    EXPECT_FALSE(sets.inSame(2, 3));
+
+    EXPECT_TRUE(sets.Union(0, 1));
+    EXPECT_TRUE(sets.Union(2, 3));
+    EXPECT_FALSE(sets.Union(1, 0));
+    EXPECT_TRUE(sets.inSame(0, 1));
+    EXPECT_TRUE(sets.inSame(2, 3));
+    EXPECT_FALSE(sets.inSame(0, 2));
+
+    sets.Union(0, 2);
+    EXPECT_TRUE(sets.inSame(1, 3));
+    EXPECT_EQ(sets.Find(0), sets.Find(3));
+}
+
+TEST(ConcurrentUFSetTest, UnionAll) {
+    const int n = 100000;
+    TinySTL::vector<std::pair<int, int>> edges;
+    srand(7);
+    for (int i = 0; i < n / 2; i++) {
+        edges.push_back(std::make_pair(rand() % n, rand() % n));
+    }
+    // a long chain through every 97th element, shuffled in with the rest
+    // so that every thread links into the same growing set
+    for (int i = 0; i + 97 < n; i += 97) {
+        edges.push_back(std::make_pair(i, i + 97));
+    }
+    for (size_t i = edges.size() - 1; i > 0; i--) {
+        std::swap(edges[i], edges[rand() % (i + 1)]);
+    }
+
+    TinySTL::UFSet expected(n);
+    for (size_t i = 0; i < edges.size(); i++) {
+        expected.Union(edges[i].first, edges[i].second);
+    }
+
+    TinySTL::ConcurrentUFSet sets(n);
+    sets.unionAll(edges.begin(), edges.end(), 4);
+    EXPECT_TRUE(sets.inSame(0, (n - 1) / 97 * 97));
+    for (int i = 0; i < n; i++) {
+        int j = (i * 7919) % n;
+        EXPECT_EQ(expected.inSame(i, j), sets.inSame(i, j));
+    }
+}
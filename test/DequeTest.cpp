@@ -1,6 +1,117 @@
+#include <string>
 #include "Deque.hpp"
+#include "Stack.hpp"
 #include "gtest/gtest.h"
 
-TEST(DequeTest, test1) {
+TEST(DequeTest, PushAndPop) {
+    TinySTL::deque<int> dq;
+    EXPECT_TRUE(dq.empty());
 
-}
\ No newline at end of file
+    for (int i = 0; i < 10000; i++) {
+        dq.push_back(i);
+        dq.push_front(-i - 1);
+    }
+    EXPECT_EQ((size_t)20000, dq.size());
+    EXPECT_EQ(-10000, dq.front());
+    EXPECT_EQ(9999, dq.back());
+    for (int i = 0; i < 20000; i++) {
+        EXPECT_EQ(i - 10000, dq[i]);
+    }
+
+    for (int i = 0; i < 5000; i++) {
+        dq.pop_front();
+        dq.pop_back();
+    }
+    EXPECT_EQ((size_t)10000, dq.size());
+    EXPECT_EQ(-5000, dq.front());
+    EXPECT_EQ(4999, dq.back());
+
+    while (!dq.empty()) {
+        dq.pop_front();
+    }
+    EXPECT_EQ((size_t)0, dq.size());
+    dq.push_front(1);
+    EXPECT_EQ(1, dq.back());
+}
+
+TEST(DequeTest, StableReferences) {
+    TinySTL::deque<int> dq;
+    dq.push_back(42);
+    int* p = &dq.front();
+    for (int i = 0; i < 100000; i++) {
+        dq.push_back(i);
+        dq.push_front(i);
+    }
+    EXPECT_EQ(p, &dq[100000]);
+    EXPECT_EQ(42, *p);
+}
+
+TEST(DequeTest, Iterator) {
+    TinySTL::deque<int> dq;
+    for (int i = 0; i < 5000; i++) {
+        dq.push_back(i);
+    }
+    typedef TinySTL::Iterator::iterator_traits<TinySTL::deque<int>::iterator> traits;
+    EXPECT_TRUE((std::is_same<traits::iterator_category,
+                 TinySTL::Iterator::random_access_iterator_tag>::value));
+
+    TinySTL::deque<int>::iterator it = dq.begin();
+    EXPECT_EQ(5000, dq.end() - it);
+    it += 4321;
+    EXPECT_EQ(4321, *it);
+    it -= 4000;
+    EXPECT_EQ(321, *it);
+    EXPECT_EQ(1321, it[1000]);
+    EXPECT_TRUE(it < dq.end());
+    EXPECT_TRUE(dq.begin() < it);
+
+    int expected = 0;
+    for (TinySTL::deque<int>::const_iterator p = dq.cbegin(); p != dq.cend(); ++p) {
+        EXPECT_EQ(expected++, *p);
+    }
+    for (TinySTL::deque<int>::iterator p = dq.end(); p != dq.begin();) {
+        --p;
+        EXPECT_EQ(--expected, *p);
+    }
+}
+
+TEST(DequeTest, InsertAndErase) {
+    TinySTL::deque<std::string> dq{ "a", "b", "c", "d", "e" };
+    dq.insert(dq.begin() + 1, "x");
+    dq.insert(dq.begin() + 5, "y");
+    dq.insert(dq.begin(), "first");
+    dq.insert(dq.end(), "last");
+    TinySTL::deque<std::string> expected{ "first", "a", "x", "b", "c", "d", "y", "e", "last" };
+    EXPECT_TRUE(dq == expected);
+
+    dq.erase(dq.begin() + 2);
+    dq.erase(dq.begin() + 5);
+    dq.erase(dq.begin());
+    dq.erase(dq.end() - 1);
+    TinySTL::deque<std::string> expected2{ "a", "b", "c", "d", "e" };
+    EXPECT_TRUE(dq == expected2);
+
+    dq.erase(dq.begin() + 1, dq.begin() + 4);
+    EXPECT_EQ((size_t)2, dq.size());
+    EXPECT_EQ("a", dq.front());
+    EXPECT_EQ("e", dq.back());
+
+    TinySTL::deque<std::string> copy(dq);
+    TinySTL::deque<std::string> moved(std::move(dq));
+    EXPECT_TRUE(copy == moved);
+    EXPECT_TRUE(dq.empty());
+    dq = copy;
+    EXPECT_TRUE(dq == copy);
+}
+
+TEST(DequeTest, Stack) {
+    TinySTL::stack<int, TinySTL::deque<int>> st;
+    for (int i = 0; i <= 10000; i++) {
+        st.push(i);
+    }
+    for (int i = 10000; i >= 0; i--) {
+        EXPECT_EQ(i, st.top());
+        st.pop();
+    }
+    EXPECT_TRUE(st.empty());
+}
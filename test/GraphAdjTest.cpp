@@ -2,10 +2,14 @@
 #define GRAPHADJ_TEST_CPP
 
 #include "GraphAdj.hpp"
+#include "Vector.hpp"
 #include "gtest/gtest.h"
 
+#include <algorithm>
 #include <cstdio>
+#include <utility>
 #include <iostream>
+#include <string>
 
 using namespace std;
 using namespace TinySTL;
@@ -210,4 +214,265 @@ TEST(GraphAdjTest, Reverse) {
     EXPECT_EQ(g1.getFirstNeighbour(3), 2);
     EXPECT_EQ(g1.getFirstNeighbour(4), 2);
 }
+
+TEST(GraphAdjTest, Neighbours) {
+    GraphAdj<int, double> g;
+    for (int i = 0; i < 4; i++) {
+        g.insertVertex(i);
+    }
+    g.insertEdge(0, 1, 0.5);
+    g.insertEdge(0, 2, 1.5);
+    g.insertEdge(0, 3, 2.5);
+    g.insertEdge(3, 0, 3.5);
+
+    EXPECT_TRUE(g.neighbours(1).empty());
+    EXPECT_FALSE(g.neighbours(3).empty());
+
+    // same order as getFirstNeighbour/getNextNeighbour
+    int u = g.getFirstNeighbour(0);
+    double sum = 0;
+    for (const auto &e : g.neighbours(0)) {
+        EXPECT_EQ(e.dest, u);
+        EXPECT_EQ(e.weight, g.getWeight(0, e.dest));
+        sum += e.weight;
+        u = g.getNextNeighbour(0, u);
+    }
+    EXPECT_EQ(u, -1);
+    EXPECT_EQ(sum, 4.5);
+
+    // the generic range of the Graph interface
+    Graph<int, double> &base = g;
+    u = g.getFirstNeighbour(0);
+    size_t n = 0;
+    for (auto e : base.neighbours(0)) {
+        EXPECT_EQ(e.dest, u);
+        EXPECT_EQ(e.weight, g.getWeight(0, e.dest));
+        u = g.getNextNeighbour(0, u);
+        n++;
+    }
+    EXPECT_EQ(n, 3);
+    for (auto e : base.neighbours(2)) {
+        (void)e;
+        EXPECT_TRUE(false);
+    }
+}
+
+TEST(GraphAdjTest, NeighboursMultigraph) {
+    GraphAdj<int, int> g;
+    for (int i = 0; i < 3; i++) {
+        g.insertVertex(i);
+    }
+    g.insertEdge(0, 1, 10);
+    g.insertEdge(0, 2, 20);
+    g.insertEdge(0, 1, 30);
+
+    // the generic range visits each parallel edge once, with its own weight
+    Graph<int, int> &base = g;
+    int dests[3], weights[3];
+    size_t n = 0;
+    for (auto e : base.neighbours(0)) {
+        ASSERT_LT(n, 3);
+        dests[n] = e.dest;
+        weights[n] = e.weight;
+        n++;
+    }
+    ASSERT_EQ(n, 3);
+    size_t i = 0;
+    for (const auto &e : g.neighbours(0)) {
+        EXPECT_EQ(e.dest, dests[i]);
+        EXPECT_EQ(e.weight, weights[i]);
+        i++;
+    }
+    EXPECT_EQ(weights[0] + weights[1] + weights[2], 60);
+}
+
+TEST(GraphAdjTest, VertexIndex) {
+    GraphAdj<long long> g;
+    g.insertVertex(1000000000000LL);
+    g.insertVertex(7);
+    EXPECT_FALSE(g.vertexIndexEnabled());
+    g.enableVertexIndex();
+    EXPECT_TRUE(g.vertexIndexEnabled());
+    for (long long id = 100; id < 200; id++) {
+        g.insertVertex(id * 3);
+    }
+    EXPECT_EQ(0, g.getVertexPos(1000000000000LL));
+    EXPECT_EQ(1, g.getVertexPos(7));
+    EXPECT_EQ(2, g.getVertexPos(300));
+    EXPECT_EQ(101, g.getVertexPos(597));
+    EXPECT_EQ(-1, g.getVertexPos(301));
+
+    // removal moves the last vertex into the freed slot
+    g.removeVertex(1);
+    EXPECT_EQ(-1, g.getVertexPos(7));
+    EXPECT_EQ(1, g.getVertexPos(597));
+    g.removeVertex(g.numOfVertices() - 1);
+    EXPECT_EQ(-1, g.getVertexPos(594));
+    for (size_t v = 0; v < g.numOfVertices(); v++) {
+        EXPECT_EQ((int)v, g.getVertexPos(g.getValue(v)));
+    }
+
+    GraphAdj<long long> copy(g);
+    EXPECT_TRUE(copy.vertexIndexEnabled());
+    EXPECT_EQ(1, copy.getVertexPos(597));
+
+    g.enableVertexIndex(false);
+    EXPECT_EQ(1, g.getVertexPos(597));
+    copy = g;
+    EXPECT_FALSE(copy.vertexIndexEnabled());
+    g = copy;
+    EXPECT_EQ(1, g.getVertexPos(597));
+}
+
+// no std::hash specialization: fine as long as the index stays disabled
+struct Point {
+    int x, y;
+    Point(int x = 0, int y = 0) : x(x), y(y) {}
+    bool operator==(const Point &rhs) const { return x == rhs.x && y == rhs.y; }
+};
+
+TEST(GraphAdjTest, NonHashableVertex) {
+    GraphAdj<Point> g;
+    for (int i = 0; i < 5; i++) {
+        g.insertVertex(Point(i, -i));
+    }
+    g.insertEdge(0, 4, 1);
+    g.insertEdge(4, 2, 2);
+    EXPECT_FALSE(g.vertexIndexEnabled());
+    EXPECT_EQ(3, g.getVertexPos(Point(3, -3)));
+    EXPECT_EQ(-1, g.getVertexPos(Point(3, 3)));
+
+    GraphAdj<Point> copy(g);
+    copy.removeVertex(1);
+    EXPECT_EQ(1, copy.getVertexPos(Point(4, -4)));
+    g = copy;
+    EXPECT_EQ(4, g.numOfVertices());
+    EXPECT_EQ(2, g.getWeight(1, 2));
+}
+
+TEST(GraphAdjTest, RemoveRenumbers) {
+    // edges into and out of the last vertex follow it into the freed slot
+    GraphAdj<int, double> g;
+    for (int i = 0; i < 4; i++) {
+        g.insertVertex(i * 10);
+    }
+    g.insertEdge(0, 3, 1.0);
+    g.insertEdge(3, 1, 2.0);
+    g.insertEdge(3, 3, 3.0);
+    g.insertEdge(1, 2, 4.0);
+    g.removeVertex(2);
+    EXPECT_EQ(3, g.numOfVertices());
+    EXPECT_EQ(3, g.numOfEdges());
+    EXPECT_EQ(30, g.getValue(2));
+    EXPECT_EQ(1.0, g.getWeight(0, 2));
+    EXPECT_EQ(2.0, g.getWeight(2, 1));
+    EXPECT_EQ(3.0, g.getWeight(2, 2));
+    EXPECT_EQ(0, g.getOutDegree(1));
+}
+
+// edges as (source, dest) pairs, sorted, read through the out-lists
+template <typename G>
+TinySTL::vector<std::pair<int, int>> edgeSet(const G &g) {
+    TinySTL::vector<std::pair<int, int>> edges;
+    for (size_t v = 0; v < g.numOfVertices(); v++) {
+        for (const auto &e : g.neighbours(v)) {
+            edges.push_back(std::make_pair((int)v, e.dest));
+        }
+    }
+    std::sort(edges.begin(), edges.end());
+    return edges;
+}
+
+TEST(GraphAdjTest, InEdges) {
+    GraphAdj<int, double> plain, bi;
+    bi.enableInEdges();
+    EXPECT_TRUE(bi.inEdgesEnabled());
+    for (int i = 0; i < 30; i++) {
+        plain.insertVertex(i);
+        bi.insertVertex(i);
+    }
+    for (int i = 0; i < 200; i++) {
+        int v1 = (i * 7) % 30, v2 = (i * 13 + i / 30) % 30;  // self-loops and parallel edges too
+        plain.insertEdge(v1, v2, i);
+        bi.insertEdge(v1, v2, i);
+    }
+    for (int round = 0; round < 20; round++) {
+        int v = (round * 11) % plain.numOfVertices();
+        if (round % 3 == 0) {
+            int u = plain.getFirstNeighbour(v);
+            if (u != -1) {
+                plain.removeEdge(v, u);
+                bi.removeEdge(v, u);
+            }
+        } else {
+            plain.removeVertex(v);
+            bi.removeVertex(v);
+        }
+        ASSERT_EQ(plain.numOfEdges(), bi.numOfEdges());
+        ASSERT_EQ(plain.check_true_edges(), bi.numOfEdges());
+        EXPECT_TRUE(edgeSet(plain) == edgeSet(bi));
+        for (size_t u = 0; u < bi.numOfVertices(); u++) {
+            EXPECT_EQ(plain.getInDegree(u), bi.getInDegree(u));
+            size_t n = 0;
+            for (const auto &e : bi.predecessors(u)) {
+                EXPECT_EQ(bi.getValue(e.dest), plain.getValue(e.dest));
+                n++;
+            }
+            EXPECT_EQ(n, bi.getInDegree(u));
+        }
+    }
+
+    // switching the mode on later builds the same lists
+    plain.enableInEdges();
+    for (size_t u = 0; u < bi.numOfVertices(); u++) {
+        EXPECT_EQ(plain.getInDegree(u), bi.getInDegree(u));
+    }
+
+    GraphAdj<int, double> copy(bi);
+    bi.reverse();
+    EXPECT_EQ(copy.numOfEdges(), bi.numOfEdges());
+    for (size_t u = 0; u < bi.numOfVertices(); u++) {
+        EXPECT_EQ(copy.getOutDegree(u), bi.getInDegree(u));
+        EXPECT_EQ(copy.getInDegree(u), bi.getOutDegree(u));
+    }
+}
+
+TEST(GraphAdjTest, CopyAssignAndReverseKeepData) {
+    GraphAdj<int, std::string> g;  // non-trivial edge weights
+    for (int i = 0; i < 5; i++) {
+        g.insertVertex(100 + i);
+    }
+    g.insertEdge(0, 1, "a");
+    g.insertEdge(1, 2, "b");
+    g.insertEdge(4, 0, "c");
+
+    GraphAdj<int, std::string> h;
+    h.insertVertex(7);
+    h.insertEdge(0, 0, "loop");
+    h = g;
+    EXPECT_EQ(5, h.numOfVertices());
+    EXPECT_EQ(3, h.numOfEdges());
+    EXPECT_EQ(104, h.getValue(4));
+    EXPECT_EQ("c", h.getWeight(4, 0));
+    h = h;
+    EXPECT_EQ(3, h.check_true_edges());
+
+    h.reverse();
+    EXPECT_EQ(3, h.numOfEdges());
+    for (int i = 0; i < 5; i++) {
+        EXPECT_EQ(100 + i, h.getValue(i));
+    }
+    EXPECT_EQ("a", h.getWeight(1, 0));
+    EXPECT_EQ("b", h.getWeight(2, 1));
+    EXPECT_EQ("c", h.getWeight(0, 4));
+    EXPECT_EQ(0, h.getOutDegree(4));
+
+    // the copy was deep: g is untouched
+    EXPECT_EQ("a", g.getWeight(0, 1));
+    g.removeEdge(0, 1);
+    h.removeVertex(0);
+    EXPECT_EQ(2, g.numOfEdges());
+    EXPECT_EQ(1, h.numOfEdges());
+}
+
 #endif  // GRAPHADJ_TEST_CPP
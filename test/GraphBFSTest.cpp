@@ -0,0 +1,107 @@
+#include "GraphAdj.hpp"
+#include "GraphBFS.hpp"
+#include "GraphCSR.hpp"
+#include "gtest/gtest.h"
+
+#include <cstdlib>
+
+using namespace TinySTL;
+
+// plain sequential BFS distances for reference
+template <typename G>
+TinySTL::vector<int> referenceDist(const G &g, int source) {
+    TinySTL::vector<int> dist(g.numOfVertices(), -1);
+    TinySTL::vector<int> queue;
+    dist[source] = 0;
+    queue.push_back(source);
+    for (size_t head = 0; head < queue.size(); head++) {
+        int v = queue[head];
+        for (const auto &e : g.neighbours(v)) {
+            if (dist[e.dest] == -1) {
+                dist[e.dest] = dist[v] + 1;
+                queue.push_back(e.dest);
+            }
+        }
+    }
+    return dist;
+}
+
+template <typename G>
+void checkTree(const G &g, const BFSResult &r, int source) {
+    EXPECT_EQ(r.parent[source], source);
+    for (size_t v = 0; v < g.numOfVertices(); v++) {
+        if ((int)v == source || r.dist[v] == -1) {
+            continue;
+        }
+        int p = r.parent[v];
+        EXPECT_EQ(r.dist[p] + 1, r.dist[v]);
+        bool isEdge = false;
+        for (const auto &e : g.neighbours(p)) {
+            isEdge = isEdge || e.dest == (int)v;
+        }
+        EXPECT_TRUE(isEdge);
+    }
+}
+
+TEST(GraphBFSTest, GraphAdj) {
+    GraphAdj<int> g;
+    for (int i = 0; i < 6; i++) {
+        g.insertVertex(i);
+    }
+    g.insertEdge(0, 1);
+    g.insertEdge(0, 2);
+    g.insertEdge(1, 3);
+    g.insertEdge(2, 3);
+    g.insertEdge(3, 4);
+    g.insertEdge(4, 0);
+
+    BFSResult r = parallelBFS(g, 0, 2);
+    EXPECT_EQ(r.reached, 5);
+    EXPECT_EQ(r.dist[0], 0);
+    EXPECT_EQ(r.dist[1], 1);
+    EXPECT_EQ(r.dist[3], 2);
+    EXPECT_EQ(r.dist[4], 3);
+    EXPECT_EQ(r.dist[5], -1);
+    EXPECT_EQ(r.parent[5], -1);
+    checkTree(g, r, 0);
+}
+
+TEST(GraphBFSTest, RandomCSR) {
+    const int n = 20000;
+    TinySTL::vector<int> values(n, 0);
+    TinySTL::vector<WeightedEdge<int> > edges;
+    srand(3);
+    for (int i = 0; i < 8 * n; i++) {
+        // skewed sources give a few hubs, so the search goes bottom-up
+        int src = rand() % (1 + rand() % n);
+        edges.push_back(WeightedEdge<int>(src, rand() % n));
+    }
+    GraphCSR<int> g(values, edges);
+    TinySTL::vector<int> expected = referenceDist(g, 0);
+
+    ParallelBFS<GraphCSR<int> > bfs(g);
+    for (unsigned threads = 1; threads <= 4; threads *= 2) {
+        for (int opt = 0; opt < 2; opt++) {
+            BFSResult r = bfs.run(0, threads, opt == 1);
+            EXPECT_TRUE(r.dist == expected);
+            checkTree(g, r, 0);
+        }
+    }
+
+    // force bottom-up from the first level on
+    bfs.alpha = n;
+    bfs.beta = 2 * n;
+    BFSResult bottomUp = bfs.run(0, 3);
+    EXPECT_TRUE(bottomUp.dist == expected);
+    checkTree(g, bottomUp, 0);
+
+    // undirected: add every edge both ways and skip the transpose
+    size_t m = edges.size();
+    for (size_t i = 0; i < m; i++) {
+        edges.push_back(WeightedEdge<int>(edges[i].dest, edges[i].src));
+    }
+    GraphCSR<int> sym(values, edges);
+    BFSResult r = parallelBFS(sym, 7, 3, true);
+    EXPECT_TRUE(r.dist == referenceDist(sym, 7));
+    checkTree(sym, r, 7);
+}
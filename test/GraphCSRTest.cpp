@@ -0,0 +1,156 @@
+#include "GraphCSR.hpp"
+#include "gtest/gtest.h"
+
+#include <stdexcept>
+
+using namespace TinySTL;
+
+TEST(GraphCSRTest, FromGraphAdj) {
+    GraphAdj<int, double> g;
+    for (int i = 0; i < 5; i++) {
+        g.insertVertex(i * 10);
+    }
+    g.insertEdge(0, 1, 1.5);
+    g.insertEdge(0, 2, 2.5);
+    g.insertEdge(2, 3, 3.5);
+    g.insertEdge(2, 4, 4.5);
+    g.insertEdge(4, 0, 5.5);
+
+    GraphCSR<int, double> csr(g);
+    EXPECT_EQ(csr.numOfVertices(), 5);
+    EXPECT_EQ(csr.numOfEdges(), 5);
+    EXPECT_EQ(csr.getValue(3), 30);
+    EXPECT_EQ(csr.getVertexPos(40), 4);
+    EXPECT_EQ(csr.getVertexPos(7), -1);
+    EXPECT_EQ(csr.getWeight(2, 4), 4.5);
+    EXPECT_EQ(csr.getOutDegree(0), 2);
+    EXPECT_EQ(csr.getOutDegree(1), 0);
+
+    // same neighbour order as the source graph
+    for (int v = 0; v < 5; v++) {
+        int u = g.getFirstNeighbour(v);
+        EXPECT_EQ(csr.getFirstNeighbour(v), u);
+        while (u != -1) {
+            EXPECT_EQ(csr.getNextNeighbour(v, u), g.getNextNeighbour(v, u));
+            u = g.getNextNeighbour(v, u);
+        }
+    }
+
+    double sum = 0;
+    size_t n = 0;
+    for (auto e : csr.neighbours(2)) {
+        EXPECT_TRUE(e.dest == 3 || e.dest == 4);
+        sum += e.weight;
+        n++;
+    }
+    EXPECT_EQ(n, 2);
+    EXPECT_EQ(sum, 8.0);
+    EXPECT_TRUE(csr.neighbours(3).empty());
+}
+
+TEST(GraphCSRTest, FromEdgeList) {
+    TinySTL::vector<char> vertices{'a', 'b', 'c', 'd'};
+    TinySTL::vector<WeightedEdge<int> > edges;
+    edges.push_back(WeightedEdge<int>(3, 0, 30));
+    edges.push_back(WeightedEdge<int>(0, 1, 1));
+    edges.push_back(WeightedEdge<int>(0, 2, 2));
+    edges.push_back(WeightedEdge<int>(3, 1, 31));
+
+    GraphCSR<char, int> csr(vertices, edges);
+    EXPECT_EQ(csr.numOfVertices(), 4);
+    EXPECT_EQ(csr.numOfEdges(), 4);
+    EXPECT_EQ(csr.getValue(2), 'c');
+    EXPECT_EQ(csr.getOutDegree(3), 2);
+    EXPECT_EQ(csr.getOutDegree(2), 0);
+    EXPECT_EQ(csr.getWeight(3, 1), 31);
+
+    // edges keep their list order within a vertex
+    int expected[] = {0, 1};
+    int i = 0;
+    for (auto e : csr.neighbours(3)) {
+        EXPECT_EQ(e.dest, expected[i++]);
+    }
+    EXPECT_EQ(csr.getFirstNeighbour(0), 1);
+    EXPECT_EQ(csr.getNextNeighbour(0, 1), 2);
+    EXPECT_EQ(csr.getNextNeighbour(0, 2), -1);
+
+    // parallel edges through the generic Graph range
+    edges.push_back(WeightedEdge<int>(3, 0, 32));
+    GraphCSR<char, int> multi(vertices, edges);
+    Graph<char, int> &base = multi;
+    int weights[] = {30, 31, 32};
+    i = 0;
+    for (auto e : base.neighbours(3)) {
+        ASSERT_LT(i, 3);
+        EXPECT_EQ(e.weight, weights[i++]);
+    }
+    EXPECT_EQ(i, 3);
+}
+
+TEST(GraphCSRTest, Immutable) {
+    GraphCSR<int> empty;
+    EXPECT_TRUE(empty.isEmpty());
+    Graph<int, int> &g = empty;
+    EXPECT_THROW(g.insertVertex(1), std::logic_error);
+    EXPECT_THROW(g.insertEdge(0, 0, 1), std::logic_error);
+    EXPECT_THROW(g.removeVertex(0), std::logic_error);
+    EXPECT_THROW(g.removeEdge(0, 0), std::logic_error);
+}
+
+TEST(GraphCSRTest, ParallelBuild) {
+    TinySTL::vector<int> values;
+    for (int i = 0; i < 20000; i++) {
+        values.push_back(i);
+    }
+    TinySTL::vector<WeightedEdge<int> > edges;
+    for (int i = 0; i < 50000; i++) {
+        // scrambled sources, most (src, dest) pairs twice or more
+        edges.push_back(WeightedEdge<int>((i * 7919) % 20000, i % 25, i));
+    }
+
+    // any thread count gives the serial layout
+    GraphCSR<int> serial(values, edges);
+    GraphCSR<int> parallel(values, edges, 4);
+    EXPECT_EQ(serial.numOfEdges(), parallel.numOfEdges());
+    for (int v = 0; v < 20000; v++) {
+        auto it = parallel.neighbours(v).begin();
+        for (auto e : serial.neighbours(v)) {
+            EXPECT_EQ(e.dest, (*it).dest);
+            EXPECT_EQ(e.weight, (*it).weight);
+            ++it;
+        }
+    }
+
+    GraphCSR<int> sorted(values, edges, 3, GraphCSR<int>::SortNeighbours);
+    GraphCSR<int> unique(values, edges, 3, GraphCSR<int>::Deduplicate);
+    EXPECT_EQ(edges.size(), sorted.numOfEdges());
+    EXPECT_GT(edges.size(), unique.numOfEdges());
+    size_t total = 0;
+    for (int v = 0; v < 20000; v++) {
+        EXPECT_EQ(serial.getOutDegree(v), sorted.getOutDegree(v));
+        int last = -1;
+        int lastWeight = -1;
+        for (auto e : sorted.neighbours(v)) {
+            EXPECT_LE(last, e.dest);
+            if (last == e.dest) {
+                EXPECT_LT(lastWeight, e.weight);  // ties stay in list order
+            }
+            last = e.dest;
+            lastWeight = e.weight;
+        }
+        last = -1;
+        for (auto e : unique.neighbours(v)) {
+            EXPECT_LT(last, e.dest);
+            // the first edge of the list wins
+            for (auto s : sorted.neighbours(v)) {
+                if (s.dest == e.dest) {
+                    EXPECT_EQ(s.weight, e.weight);
+                    break;
+                }
+            }
+            last = e.dest;
+        }
+        total += unique.getOutDegree(v);
+    }
+    EXPECT_EQ(total, unique.numOfEdges());
+}
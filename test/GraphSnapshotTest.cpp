@@ -0,0 +1,188 @@
+#include "gtest/gtest.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+#include <utility>
+#include "GraphAdj.hpp"
+#include "GraphCSR.hpp"
+#include "GraphSnapshot.hpp"
+#include "ShortestPath.hpp"
+
+using namespace TinySTL;
+
+static std::string tempPath(const char* name) {
+    return std::string("/tmp/") + name + "." + std::to_string(getpid());
+}
+
+TEST(GraphSnapshotTest, RoundTrip) {
+    std::string path = tempPath("GraphSnapshotTest");
+    GraphAdj<long long, double> g;
+    for (int i = 0; i < 50; i++) {
+        g.insertVertex(1000 + i);
+    }
+    for (int i = 0; i < 50; i++) {
+        g.insertEdge(i, (i + 1) % 50, i * 0.5);
+        g.insertEdge(i, (i * 7) % 50, 1.0);
+    }
+    writeGraphSnapshot(g, path);
+
+    MappedGraph<long long, double> m(path);
+    EXPECT_EQ(g.numOfVertices(), m.numOfVertices());
+    EXPECT_EQ(g.numOfEdges(), m.numOfEdges());
+    for (int v = 0; v < 50; v++) {
+        EXPECT_EQ(g.getValue(v), m.getValue(v));
+        EXPECT_EQ(g.getOutDegree(v), m.getOutDegree(v));
+        // same neighbour order as the source graph
+        auto it = m.neighbours(v).begin();
+        for (const auto& e : g.neighbours(v)) {
+            EXPECT_EQ(e.dest, (*it).dest);
+            EXPECT_EQ(e.weight, (*it).weight);
+            ++it;
+        }
+        EXPECT_TRUE(it == m.neighbours(v).end());
+    }
+    EXPECT_EQ(7, m.getVertexPos(1007));
+    EXPECT_EQ(0.5, m.getWeight(1, 2));
+    EXPECT_THROW(m.insertVertex(1), std::logic_error);
+
+    // the algorithms run on the mapping directly
+    ShortestPaths<double> a = dijkstra(g, 0), b = dijkstra(m, 0);
+    for (int v = 0; v < 50; v++) {
+        EXPECT_EQ(a.dist[v], b.dist[v]);
+    }
+    std::remove(path.c_str());
+}
+
+TEST(GraphSnapshotTest, FromCSRAndEmpty) {
+    std::string path = tempPath("GraphSnapshotCSR");
+    TinySTL::vector<int> vertices;
+    TinySTL::vector<WeightedEdge<int>> edges;
+    for (int i = 0; i < 10; i++) {
+        vertices.push_back(i);
+        edges.push_back(WeightedEdge<int>(i, 9 - i, i));
+    }
+    GraphCSR<int, int> csr(vertices, edges);
+    writeGraphSnapshot(csr, path);
+    {
+        MappedGraph<int, int> m(path);
+        EXPECT_EQ(10, m.numOfEdges());
+        EXPECT_EQ(9, m.getFirstNeighbour(0));
+        EXPECT_EQ(-1, m.getNextNeighbour(0, 9));
+        EXPECT_EQ(3, m.getWeight(3, 6));
+    }
+
+    // overwriting with a smaller graph truncates the file
+    GraphAdj<int, int> empty;
+    writeGraphSnapshot(empty, path);
+    MappedGraph<int, int> m(path);
+    EXPECT_TRUE(m.isEmpty());
+    EXPECT_EQ(0, m.numOfEdges());
+
+    // wrong weight type
+    EXPECT_THROW((MappedGraph<int, double>(path)), std::runtime_error);
+    std::remove(path.c_str());
+}
+
+TEST(GraphSnapshotTest, ReplaceWhileMapped) {
+    std::string path = tempPath("GraphSnapshotReplace");
+    GraphAdj<int, int> g;
+    for (int i = 0; i < 100; i++) {
+        g.insertVertex(i);
+        g.insertEdge(i, 0, i);
+    }
+    writeGraphSnapshot(g, path);
+    MappedGraph<int, int> old(path);
+
+    // the new file replaces the old one instead of being written into it
+    GraphAdj<int, int> small;
+    small.insertVertex(42);
+    writeGraphSnapshot(small, path);
+    EXPECT_EQ(100, old.numOfEdges());
+    EXPECT_EQ(99, old.getWeight(99, 0));
+    MappedGraph<int, int> replaced(path);
+    EXPECT_EQ(1, replaced.numOfVertices());
+
+    // a snapshot of a mapped graph written over its own source
+    writeGraphSnapshot(old, path);
+    MappedGraph<int, int> copy(path);
+    EXPECT_EQ(100, copy.numOfEdges());
+    EXPECT_EQ(99, copy.getWeight(99, 0));
+    std::remove(path.c_str());
+}
+
+// copies the snapshot at from to to, with patch applied to its bytes
+template <typename Patch>
+static void corrupt(const std::string& from, const std::string& to, Patch patch) {
+    std::string bytes;
+    FILE* f = std::fopen(from.c_str(), "rb");
+    for (int c = std::fgetc(f); c != EOF; c = std::fgetc(f)) {
+        bytes.push_back((char)c);
+    }
+    std::fclose(f);
+    detail::SnapshotHeader header;
+    std::memcpy(&header, &bytes[0], sizeof(header));
+    patch(header, bytes);
+    std::memcpy(&bytes[0], &header, sizeof(header));
+    f = std::fopen(to.c_str(), "wb");
+    std::fwrite(bytes.data(), 1, bytes.size(), f);
+    std::fclose(f);
+}
+
+TEST(GraphSnapshotTest, Corrupt) {
+    std::string path = tempPath("GraphSnapshotGood");
+    std::string bad = tempPath("GraphSnapshotCorrupt");
+    GraphAdj<int, int> g;
+    for (int i = 0; i < 20; i++) {
+        g.insertVertex(i);
+    }
+    for (int i = 0; i < 20; i++) {
+        g.insertEdge(i, (i + 3) % 20, i);
+    }
+    writeGraphSnapshot(g, path);
+    typedef detail::SnapshotHeader Header;
+
+    // sizes that overflow 64 bits must not pass the bounds checks
+    corrupt(path, bad, [](Header& h, std::string&) { h.numEdges = (std::uint64_t)1 << 62; });
+    EXPECT_THROW((MappedGraph<int, int>(bad)), std::runtime_error);
+    corrupt(path, bad, [](Header& h, std::string&) { h.numVertices = ~(std::uint64_t)0; });
+    EXPECT_THROW((MappedGraph<int, int>(bad)), std::runtime_error);
+
+    corrupt(path, bad, [](Header& h, std::string&) { h.targetsOffset += 4; });
+    EXPECT_THROW((MappedGraph<int, int>(bad)), std::runtime_error);
+
+    corrupt(path, bad, [](Header& h, std::string& bytes) {
+        std::uint64_t* offsets = reinterpret_cast<std::uint64_t*>(&bytes[h.offsetsOffset]);
+        std::swap(offsets[5], offsets[6]);
+    });
+    EXPECT_THROW((MappedGraph<int, int>(bad)), std::runtime_error);
+
+    corrupt(path, bad, [](Header& h, std::string& bytes) {
+        std::int32_t* targets = reinterpret_cast<std::int32_t*>(&bytes[h.targetsOffset]);
+        targets[7] = 20;
+    });
+    EXPECT_THROW((MappedGraph<int, int>(bad)), std::runtime_error);
+    // trusted files skip the O(V + E) scans
+    MappedGraph<int, int> trusted(bad, false);
+    EXPECT_EQ(20, trusted.numOfEdges());
+
+    std::remove(bad.c_str());
+    std::remove(path.c_str());
+}
+
+TEST(GraphSnapshotTest, NotASnapshot) {
+    std::string path = tempPath("GraphSnapshotBad");
+    FILE* f = std::fopen(path.c_str(), "w");
+    std::fputs("1 2\n2 3\n", f);
+    std::fclose(f);
+    EXPECT_THROW((MappedGraph<int, int>(path)), std::runtime_error);
+    std::remove(path.c_str());
+    EXPECT_THROW((MappedGraph<int, int>(path)), std::runtime_error);
+}
+
+#endif
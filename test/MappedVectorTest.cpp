@@ -0,0 +1,136 @@
+#include "gtest/gtest.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <cstdio>
+#include <string>
+#include <unistd.h>
+#include "MappedVector.hpp"
+
+struct Record {
+    int id;
+    double value;
+};
+
+static std::string tempPath(const char* name) {
+    return std::string("/tmp/") + name + "." + std::to_string(getpid());
+}
+
+TEST(MappedVectorTest, AppendAndReopen) {
+    std::string path = tempPath("MappedVectorTest");
+    std::remove(path.c_str());
+    {
+        TinySTL::mapped_vector<Record> vec(path);
+        EXPECT_TRUE(vec.empty());
+        for (int i = 0; i < 10000; i++) {
+            vec.push_back(Record{ i, i * 0.5 });
+        }
+        EXPECT_EQ((size_t)10000, vec.size());
+        EXPECT_LE(vec.size(), vec.capacity());
+        vec.flush();
+    }
+    {
+        // closing keeps the spare tail; trimming is explicit
+        TinySTL::mapped_vector<Record> vec(path);
+        EXPECT_LT(vec.size(), vec.capacity());
+        vec.shrink_to_fit();
+    }
+    {
+        TinySTL::mapped_vector<Record> vec(path, TinySTL::mapped_file::read_only);
+        EXPECT_EQ((size_t)10000, vec.size());
+        EXPECT_EQ(vec.size(), vec.capacity());
+        int i = 0;
+        for (const Record& r : vec) {
+            EXPECT_EQ(i, r.id);
+            EXPECT_EQ(i * 0.5, r.value);
+            i++;
+        }
+        EXPECT_THROW(vec.push_back(Record{ 0, 0 }), std::runtime_error);
+        EXPECT_THROW(vec.at(10000), std::out_of_range);
+    }
+    {
+        TinySTL::mapped_vector<Record> vec(path);
+        Record more[3] = { { -1, 1 }, { -2, 2 }, { -3, 3 } };
+        vec.append(more, more + 3);
+        vec.pop_back();
+        EXPECT_EQ((size_t)10002, vec.size());
+        EXPECT_EQ(-2, vec.back().id);
+        EXPECT_EQ(9999, vec[9999].id);
+    }
+    {
+        // wrong record size is rejected
+        EXPECT_THROW(TinySTL::mapped_vector<char> bad(path), std::runtime_error);
+    }
+    std::remove(path.c_str());
+}
+
+TEST(MappedVectorTest, Resize) {
+    std::string path = tempPath("MappedVectorResize");
+    std::remove(path.c_str());
+    TinySTL::mapped_vector<long long> vec(path);
+    vec.resize(100, 7);
+    EXPECT_EQ((size_t)100, vec.size());
+    EXPECT_EQ(7, vec.at(99));
+    vec.resize(10);
+    vec.shrink_to_fit();
+    EXPECT_EQ((size_t)10, vec.capacity());
+    vec.clear();
+    EXPECT_TRUE(vec.empty());
+    vec.close();
+    std::remove(path.c_str());
+}
+
+TEST(MappedVectorTest, ReaderWhileWriterGrows) {
+    std::string path = tempPath("MappedVectorGrow");
+    std::remove(path.c_str());
+    TinySTL::mapped_vector<Record> writer(path);
+    for (int i = 0; i < 10; i++) {
+        writer.push_back(Record{ i, 0 });
+    }
+    writer.shrink_to_fit();
+
+    // the reader only sees what fits in its own mapping
+    TinySTL::mapped_vector<Record> reader(path, TinySTL::mapped_file::read_only);
+    for (int i = 10; i < 100010; i++) {
+        writer.push_back(Record{ i, 0 });
+    }
+    EXPECT_EQ((size_t)10, reader.size());
+    int i = 0;
+    for (const Record& r : reader) {
+        EXPECT_EQ(i++, r.id);
+    }
+    EXPECT_EQ(10, i);
+
+    reader.open(path, TinySTL::mapped_file::read_only);
+    EXPECT_EQ((size_t)100010, reader.size());
+    EXPECT_EQ(100009, reader.back().id);
+    std::remove(path.c_str());
+}
+
+TEST(MappedVectorTest, Corrupt) {
+    std::string path = tempPath("MappedVectorCorrupt");
+    std::remove(path.c_str());
+    {
+        TinySTL::mapped_vector<Record> vec(path);
+        for (int i = 0; i < 100; i++) {
+            vec.push_back(Record{ i, 0 });
+        }
+        vec.shrink_to_fit();
+    }
+    // a count past the end of the file
+    ASSERT_EQ(0, truncate(path.c_str(), 64 + 50 * sizeof(Record)));
+    EXPECT_THROW(TinySTL::mapped_vector<Record> bad(path, TinySTL::mapped_file::read_only),
+                 std::runtime_error);
+    // a count large enough to overflow the size computation
+    {
+        FILE* f = std::fopen(path.c_str(), "r+b");
+        unsigned long long count = ~0ULL / sizeof(Record) + 2;
+        std::fseek(f, 16, SEEK_SET);
+        std::fwrite(&count, sizeof(count), 1, f);
+        std::fclose(f);
+    }
+    EXPECT_THROW(TinySTL::mapped_vector<Record> bad(path), std::runtime_error);
+    std::remove(path.c_str());
+}
+
+#endif
@@ -0,0 +1,76 @@
+#include <string>
+#include "Memory.hpp"
+#include "gtest/gtest.h"
+
+TEST(MemoryTest, CopyTrivial) {
+    int src[100];
+    for (int i = 0; i < 100; i++) {
+        src[i] = i;
+    }
+    int* dst = static_cast<int*>(::operator new(100 * sizeof(int)));
+    int* end = TinySTL::uninitialized_copy(src, src + 100, dst);
+    EXPECT_EQ(dst + 100, end);
+    for (int i = 0; i < 100; i++) {
+        EXPECT_EQ(i, dst[i]);
+    }
+
+    const int* csrc = src;
+    end = TinySTL::uninitialized_copy_n(csrc + 50, 50, dst);
+    EXPECT_EQ(dst + 50, end);
+    for (int i = 0; i < 50; i++) {
+        EXPECT_EQ(i + 50, dst[i]);
+    }
+    ::operator delete(dst);
+}
+
+TEST(MemoryTest, CopyNonTrivial) {
+    std::string src[10];
+    for (int i = 0; i < 10; i++) {
+        src[i] = std::string(i + 20, 'a' + i);
+    }
+    std::string* dst = static_cast<std::string*>(::operator new(10 * sizeof(std::string)));
+    TinySTL::uninitialized_copy_n(src, 10, dst);
+    for (int i = 0; i < 10; i++) {
+        EXPECT_EQ(src[i], dst[i]);
+        dst[i].~basic_string();
+    }
+    ::operator delete(dst);
+}
+
+TEST(MemoryTest, Fill) {
+    char* bytes = static_cast<char*>(::operator new(64));
+    TinySTL::uninitialized_fill(bytes, bytes + 64, 'x');
+    for (int i = 0; i < 64; i++) {
+        EXPECT_EQ('x', bytes[i]);
+    }
+    ::operator delete(bytes);
+
+    double* dst = static_cast<double*>(::operator new(100 * sizeof(double)));
+    double* end = TinySTL::uninitialized_fill_n(dst, 100, 1);
+    EXPECT_EQ(dst + 100, end);
+    for (int i = 0; i < 100; i++) {
+        EXPECT_EQ(1.0, dst[i]);
+    }
+    ::operator delete(dst);
+
+    // trivially copyable but not assignable
+    struct Key {
+        const int id;
+        int value;
+    };
+    Key* keys = static_cast<Key*>(::operator new(10 * sizeof(Key)));
+    TinySTL::uninitialized_fill(keys, keys + 10, Key{7, 3});
+    for (int i = 0; i < 10; i++) {
+        EXPECT_EQ(7, keys[i].id);
+        EXPECT_EQ(3, keys[i].value);
+    }
+    ::operator delete(keys);
+
+    std::string* str = static_cast<std::string*>(::operator new(10 * sizeof(std::string)));
+    TinySTL::uninitialized_fill_n(str, 10, std::string("tiny"));
+    for (int i = 0; i < 10; i++) {
+        EXPECT_EQ("tiny", str[i]);
+        str[i].~basic_string();
+    }
+    ::operator delete(str);
+}
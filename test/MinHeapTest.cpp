@@ -48,4 +48,18 @@ TEST(MinHeapTest, RandomInsertAndRemove) {
     EXPECT_EQ(-100, x);
 }
 
+TEST(MinHeapTest, Sorted) {
+    MinHeap<int> heap;
+    for (int i = 0; i < 1000; i++) {
+        heap.insert((i * 7919) % 257);  // every key about four times
+    }
+    int last = -1;
+    int x;
+    while (heap.remove(x)) {
+        EXPECT_LE(last, x);
+        last = x;
+    }
+    EXPECT_EQ(256, last);
+}
+
 #endif  // MINHEAPTEST_HPP
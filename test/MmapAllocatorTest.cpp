@@ -0,0 +1,64 @@
+#include "MmapAllocator.hpp"
+#include "Vector.hpp"
+#include "gtest/gtest.h"
+
+TEST(MmapAllocatorTest, Reallocate) {
+    EXPECT_TRUE((TinySTL::allocator_has_reallocate<TinySTL::mmap_allocator<int>>::value));
+    EXPECT_FALSE((TinySTL::allocator_has_reallocate<TinySTL::allocator<int>>::value));
+
+    TinySTL::mmap_allocator<int, 4096> alloc;
+    int* p = alloc.allocate(100);  // below the threshold
+    for (int i = 0; i < 100; i++) {
+        p[i] = i;
+    }
+    size_t copied = 0;
+    p = alloc.reallocate(p, 100, 10000, &copied);  // heap -> mapping
+    EXPECT_EQ(100 * sizeof(int), copied);
+    for (int i = 100; i < 10000; i++) {
+        p[i] = i;
+    }
+    p = alloc.reallocate(p, 10000, 1000000, &copied);  // mapping -> mapping
+#if defined(__linux__)
+    EXPECT_EQ((size_t)0, copied);
+#endif
+    for (int i = 0; i < 10000; i++) {
+        EXPECT_EQ(i, p[i]);
+    }
+    p[999999] = 1;
+    p = alloc.reallocate(p, 1000000, 50);  // back to the heap
+    for (int i = 0; i < 50; i++) {
+        EXPECT_EQ(i, p[i]);
+    }
+    alloc.deallocate(p, 50);
+}
+
+TEST(MmapAllocatorTest, Vector) {
+    TinySTL::vector<long long, TinySTL::mmap_allocator<long long, 4096, true>> vec;
+    for (long long i = 0; i < 1000000; i++) {
+        vec.push_back(i);
+    }
+    EXPECT_EQ((size_t)1000000, vec.size());
+    for (long long i = 0; i < 1000000; i++) {
+        EXPECT_EQ(i, vec[i]);
+    }
+    vec.resize(10);
+    vec.shrink_to_fit();
+    EXPECT_EQ((size_t)10, vec.capacity());
+    EXPECT_EQ(9, vec.back());
+}
+
+TEST(MmapAllocatorTest, CountedGrowth) {
+    typedef TinySTL::counted_growth<TinySTL::growth_2x> Counted;
+    Counted::reset();
+    {
+        TinySTL::vector<int, TinySTL::mmap_allocator<int, 4096>, Counted> vec;
+        for (int i = 0; i < 100000; i++) {
+            vec.push_back(i);
+        }
+    }
+    EXPECT_EQ((size_t)18, Counted::stats().reallocations.load());
+#if defined(__linux__)
+    // only the heap buffers up to 512 ints are copied; mremap moves the rest
+    EXPECT_EQ(1023 * sizeof(int), Counted::stats().bytesMoved.load());
+#endif
+}
@@ -0,0 +1,86 @@
+#include "GraphAdj.hpp"
+#include "GraphCSR.hpp"
+#include "ShortestPath.hpp"
+#include "gtest/gtest.h"
+
+#include <cstdlib>
+
+using namespace TinySTL;
+
+template <typename G, typename E>
+void checkTree(const G &g, const ShortestPaths<E> &r, int source) {
+    EXPECT_EQ(r.parent[source], source);
+    for (size_t v = 0; v < g.numOfVertices(); v++) {
+        if ((int)v == source) {
+            continue;
+        }
+        if (r.dist[v] == ShortestPaths<E>::unreachable()) {
+            EXPECT_EQ(r.parent[v], -1);
+            continue;
+        }
+        int p = r.parent[v];
+        ASSERT_NE(p, -1);
+        bool tight = false;
+        for (const auto &e : g.neighbours(p)) {
+            tight = tight || (e.dest == (int)v && r.dist[p] + e.weight == r.dist[v]);
+        }
+        EXPECT_TRUE(tight);
+    }
+}
+
+TEST(ShortestPathTest, Small) {
+    GraphAdj<char, int> g;
+    for (char c = 'a'; c <= 'f'; c++) {
+        g.insertVertex(c);
+    }
+    g.insertEdge(0, 1, 7);
+    g.insertEdge(0, 2, 9);
+    g.insertEdge(0, 5, 14);
+    g.insertEdge(1, 2, 10);
+    g.insertEdge(1, 3, 15);
+    g.insertEdge(2, 3, 11);
+    g.insertEdge(2, 5, 2);
+    g.insertEdge(3, 4, 6);
+    g.insertEdge(5, 4, 9);
+
+    ShortestPaths<int> r = dijkstra(g, 0);
+    int expected[] = {0, 7, 9, 20, 20, 11};
+    for (int v = 0; v < 6; v++) {
+        EXPECT_EQ(r.dist[v], expected[v]);
+    }
+    EXPECT_EQ(r.parent[4], 5);
+    EXPECT_EQ(r.parent[5], 2);
+    checkTree(g, r, 0);
+
+    ShortestPaths<int> unreached = dijkstra(g, 4);
+    EXPECT_EQ(unreached.dist[4], 0);
+    EXPECT_EQ(unreached.dist[0], ShortestPaths<int>::unreachable());
+
+    for (unsigned threads = 1; threads <= 3; threads++) {
+        ShortestPaths<int> p = deltaStepping(g, 0, 5, threads);
+        EXPECT_TRUE(p.dist == r.dist);
+        checkTree(g, p, 0);
+    }
+}
+
+TEST(ShortestPathTest, RandomGraph) {
+    const int n = 5000;
+    TinySTL::vector<int> values(n, 0);
+    TinySTL::vector<WeightedEdge<double> > edges;
+    srand(11);
+    for (int i = 0; i < 6 * n; i++) {
+        // a few zero-weight edges as well
+        double w = (rand() % 10 == 0) ? 0.0 : (rand() % 1000) / 8.0;
+        edges.push_back(WeightedEdge<double>(rand() % n, rand() % n, w));
+    }
+    GraphCSR<int, double> g(values, edges);
+
+    ShortestPaths<double> r = dijkstra(g, 0);
+    checkTree(g, r, 0);
+    double deltas[] = {0.0, 1.0, 50.0, 1000.0};
+    for (int i = 0; i < 4; i++) {
+        ShortestPaths<double> p = deltaStepping(g, 0, deltas[i], 4);
+        EXPECT_TRUE(p.dist == r.dist);
+        checkTree(g, p, 0);
+    }
+}
@@ -0,0 +1,81 @@
+#include <string>
+#include "SmallVector.hpp"
+#include "gtest/gtest.h"
+
+TEST(SmallVectorTest, Inline) {
+    TinySTL::small_vector<int, 4> vec;
+    EXPECT_TRUE(vec.empty());
+    EXPECT_TRUE(vec.is_inline());
+    EXPECT_EQ((size_t)4, vec.capacity());
+
+    for (int i = 0; i < 4; i++) {
+        vec.push_back(i);
+        EXPECT_TRUE(vec.is_inline());
+    }
+    vec.push_back(4);
+    EXPECT_FALSE(vec.is_inline());
+    EXPECT_EQ((size_t)5, vec.size());
+    for (int i = 0; i < 5; i++) {
+        EXPECT_EQ(i, vec.at(i));
+    }
+
+    vec.clear();
+    EXPECT_TRUE(vec.empty());
+    EXPECT_TRUE(vec.is_inline());
+}
+
+TEST(SmallVectorTest, Constructor) {
+    TinySTL::small_vector<int, 8> vec1(5, 7);
+    EXPECT_EQ((size_t)5, vec1.size());
+    for (size_t i = 0; i < 5; i++) {
+        EXPECT_EQ(7, vec1[i]);
+    }
+
+    TinySTL::small_vector<int, 8> vec2{ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+    EXPECT_EQ((size_t)10, vec2.size());
+    EXPECT_FALSE(vec2.is_inline());
+
+    TinySTL::small_vector<int, 8> vec3(vec2);
+    EXPECT_TRUE(vec3 == vec2);
+
+    TinySTL::small_vector<int, 8> vec4(vec2.begin(), vec2.begin() + 3);
+    EXPECT_EQ((size_t)3, vec4.size());
+    EXPECT_TRUE(vec4 < vec2);
+
+    TinySTL::small_vector<int, 8> vec5(std::move(vec4));
+    EXPECT_TRUE(vec4.empty());
+    EXPECT_EQ(3, vec5.back());
+
+    const int* heap = vec2.data();
+    TinySTL::small_vector<int, 8> vec6(std::move(vec2));
+    EXPECT_EQ(heap, vec6.data());
+    EXPECT_TRUE(vec2.empty());
+    EXPECT_TRUE(vec2.is_inline());
+}
+
+TEST(SmallVectorTest, Strings) {
+    TinySTL::small_vector<std::string, 2> vec;
+    for (int i = 0; i < 20; i++) {
+        vec.push_back(std::string(30, 'a' + i));
+    }
+    vec.insert(vec.begin(), std::string("first"));
+    vec.insert(vec.begin() + 10, vec[0]);
+    EXPECT_EQ((size_t)22, vec.size());
+    EXPECT_EQ("first", vec.front());
+    EXPECT_EQ("first", vec[10]);
+    EXPECT_EQ(std::string(30, 'a'), vec[1]);
+
+    vec.erase(vec.begin() + 10);
+    vec.erase(vec.begin());
+    for (int i = 0; i < 20; i++) {
+        EXPECT_EQ(std::string(30, 'a' + i), vec[i]);
+    }
+
+    vec.resize(1);
+    TinySTL::small_vector<std::string, 2> other{ "x", "y" };
+    vec.swap(other);
+    EXPECT_EQ((size_t)2, vec.size());
+    EXPECT_EQ("y", vec.back());
+    EXPECT_EQ((size_t)1, other.size());
+    EXPECT_EQ(std::string(30, 'a'), other[0]);
+}
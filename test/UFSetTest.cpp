@@ -18,4 +18,67 @@ TEST(UFSetTest, test1) {
     EXPECT_TRUE(sets.inSame(0, 2));
 }
 
+TEST(UFSetTest, RankAndCompact) {
+    const int n = 1 << 12;
+    TinySTL::UFSet bySize(n);
+    TinySTL::RankedUFSet byRank(n);
+    // binomial trees: the deepest shape union by size/rank can produce
+    for (int step = 1; step < n; step *= 2) {
+        for (int i = 0; i + step < n; i += 2 * step) {
+            bySize.Union(i, i + step);
+            byRank.Union(i + step, i);
+        }
+        if (step == 64) {
+            EXPECT_TRUE(bySize.inSame(0, 127));
+            EXPECT_FALSE(bySize.inSame(0, 128));
+            EXPECT_TRUE(byRank.inSame(128, 255));
+            EXPECT_FALSE(byRank.inSame(127, 128));
+        }
+    }
+    byRank.compact();
+    bySize.compact();
+    for (int i = 0; i < n; i++) {
+        EXPECT_TRUE(bySize.inSame(0, i));
+        EXPECT_TRUE(byRank.inSame(i, n - 1));
+    }
 
+    const TinySTL::UFSet& constSets = bySize;
+    EXPECT_EQ(constSets.Find(0), constSets.Find(n - 1));
+}
+
+TEST(UFSetTest, Rollback) {
+    TinySTL::RollbackUFSet sets(8);
+    EXPECT_TRUE(sets.Union(0, 1));
+    EXPECT_TRUE(sets.Union(2, 3));
+    EXPECT_EQ((size_t)6, sets.components());
+
+    size_t cp = sets.checkpoint();
+    EXPECT_TRUE(sets.Union(1, 2));
+    EXPECT_TRUE(sets.Union(4, 5));
+    EXPECT_FALSE(sets.Union(0, 3));
+    EXPECT_TRUE(sets.inSame(0, 3));
+
+    size_t cp2 = sets.checkpoint();
+    EXPECT_TRUE(sets.Union(5, 0));
+    EXPECT_TRUE(sets.inSame(4, 3));
+    EXPECT_EQ((size_t)3, sets.components());
+
+    sets.rollback(cp2);
+    EXPECT_FALSE(sets.inSame(4, 3));
+    EXPECT_TRUE(sets.inSame(0, 3));
+
+    sets.rollback(cp);
+    EXPECT_FALSE(sets.inSame(0, 3));
+    EXPECT_FALSE(sets.inSame(4, 5));
+    EXPECT_TRUE(sets.inSame(0, 1));
+    EXPECT_TRUE(sets.inSame(2, 3));
+    EXPECT_EQ((size_t)6, sets.components());
+
+    sets.rollback(0);
+    EXPECT_EQ((size_t)8, sets.components());
+    EXPECT_FALSE(sets.inSame(0, 1));
+    for (int i = 1; i < 8; i++) {
+        sets.Union(0, i);
+    }
+    EXPECT_EQ((size_t)1, sets.components());
+}
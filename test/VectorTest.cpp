@@ -2,6 +2,7 @@
 #define VECTORTEST_HPP
 
 #include <iostream>
+#include <string>
 #include "Vector.hpp"
 #include "gtest/gtest.h"
 
@@ -225,4 +226,117 @@ TEST(VectorTest, Relation) {
     EXPECT_TRUE(vec1 != vec2);
 }
 
+struct MoveCounter {
+    static int copies;
+    static int moves;
+    int value;
+    MoveCounter(int v = 0) : value(v) {}
+    MoveCounter(const MoveCounter& rhs) : value(rhs.value) { copies++; }
+    MoveCounter(MoveCounter&& rhs) noexcept : value(rhs.value) { moves++; }
+    MoveCounter& operator=(const MoveCounter& rhs) { value = rhs.value; return *this; }
+};
+int MoveCounter::copies = 0;
+int MoveCounter::moves = 0;
+
+TEST(VectorTest, Relocate) {
+    TinySTL::vector<std::string> strs;
+    for (int i = 0; i < 1000; i++) {
+        strs.push_back(std::string(32, 'a' + i % 26));
+    }
+    EXPECT_EQ((size_t)1000, strs.size());
+    for (int i = 0; i < 1000; i++) {
+        EXPECT_EQ(std::string(32, 'a' + i % 26), strs[i]);
+    }
+
+    // pushing one of its own elements across a reallocation
+    strs.reserve(strs.size());
+    strs.push_back(strs[0]);
+    EXPECT_EQ(strs[0], strs.back());
+
+    TinySTL::vector<TinySTL::vector<int>> nested;
+    for (int i = 0; i < 100; i++) {
+        nested.push_back(TinySTL::vector<int>(i, i));
+    }
+    for (int i = 0; i < 100; i++) {
+        EXPECT_EQ((size_t)i, nested[i].size());
+        for (int j = 0; j < i; j++) {
+            EXPECT_EQ(i, nested[i][j]);
+        }
+    }
+
+    TinySTL::vector<MoveCounter> counters;
+    for (int i = 0; i < 100; i++) {
+        counters.emplace_back(i);
+    }
+    EXPECT_EQ(0, MoveCounter::copies);
+    EXPECT_LT(0, MoveCounter::moves);
+    for (int i = 0; i < 100; i++) {
+        EXPECT_EQ(i, counters[i].value);
+    }
+}
+
+TEST(VectorTest, Move) {
+    TinySTL::vector<int> vec1(10, 1);
+    const int* data = vec1.data();
+    TinySTL::vector<int> vec2(std::move(vec1));
+    EXPECT_TRUE(vec1.empty());
+    EXPECT_EQ(data, vec2.data());
+    EXPECT_EQ((size_t)10, vec2.size());
+}
+
+TEST(VectorTest, ShrinkToFit) {
+    TinySTL::vector<int> vec;
+    for (int i = 0; i < 100; i++) {
+        vec.push_back(i);
+    }
+    EXPECT_LT((size_t)100, vec.capacity());
+    vec.shrink_to_fit();
+    EXPECT_EQ((size_t)100, vec.capacity());
+    for (int i = 0; i < 100; i++) {
+        EXPECT_EQ(i, vec[i]);
+    }
+
+    vec.erase(vec.begin() + 10, vec.end());
+    vec.shrink_to_fit();
+    EXPECT_EQ((size_t)10, vec.capacity());
+
+    vec.erase(vec.begin(), vec.end());
+    vec.shrink_to_fit();
+    EXPECT_EQ((size_t)0, vec.capacity());
+    EXPECT_TRUE(vec.data() == nullptr);
+    vec.push_back(1);
+    EXPECT_EQ(1, vec.back());
+}
+
+TEST(VectorTest, GrowthPolicy) {
+    TinySTL::vector<int, TinySTL::allocator<int>, TinySTL::growth_1_5x> vec;
+    size_t expected[] = { 1, 2, 3, 4, 6, 9, 13, 19 };
+    for (size_t i = 0; i < sizeof(expected) / sizeof(expected[0]); i++) {
+        vec.resize(vec.capacity());
+        vec.push_back(0);
+        EXPECT_EQ(expected[i], vec.capacity());
+    }
+
+    // 1 MiB and up is rounded to whole 4 KiB pages
+    typedef TinySTL::page_growth<4096, (1 << 20)> Page;
+    EXPECT_EQ((size_t)3, Page::grow(2, 1, sizeof(int)));
+    size_t cap = Page::grow(300000, 1, sizeof(int));
+    EXPECT_EQ((size_t)0, cap * sizeof(int) % 4096);
+    EXPECT_LE((size_t)450000, cap);
+
+    typedef TinySTL::counted_growth<TinySTL::growth_2x> Counted;
+    Counted::reset();
+    {
+        TinySTL::vector<int, TinySTL::allocator<int>, Counted> counted;
+        for (int i = 0; i < 1000; i++) {
+            counted.push_back(i);
+        }
+        counted.shrink_to_fit();
+    }
+    // 1, 2, 4, ..., 1024 plus the final shrink
+    EXPECT_EQ((size_t)12, Counted::stats().reallocations.load());
+    EXPECT_EQ((1023 + 1000) * sizeof(int), Counted::stats().bytesMoved.load());
+    EXPECT_EQ((2047 + 1000) * sizeof(int), Counted::stats().bytesAllocated.load());
+}
+
 #endif  // VECTORTEST_HPP
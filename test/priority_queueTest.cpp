@@ -3,6 +3,7 @@
 
 #include <functional>
 #include <iostream>
+#include <iterator>
 
 TEST(PriorityQueueTest, test1) {
     TinySTL::priority_queue<int> pq;
@@ -61,4 +62,211 @@ TEST(PriorityQueueTest, test3) {
         EXPECT_EQ(i, pq.top().k);
         pq.pop();
     }
-}
\ No newline at end of file
+}
+
+TEST(PriorityQueueTest, Arity) {
+    TinySTL::vector<int> vec;
+    for (int i = 0; i < 1000; i++) {
+        vec.push_back((i * 7919) % 1000);
+    }
+
+    TinySTL::priority_queue<int, TinySTL::vector<int>, std::less<int>, 4> pq4;
+    EXPECT_TRUE(pq4.empty());
+    for (size_t i = 0; i < vec.size(); i++) {
+        pq4.push(vec[i]);
+    }
+    EXPECT_EQ(vec.size(), pq4.size());
+    for (int i = 0; i < 1000; i++) {
+        EXPECT_EQ(i, pq4.top());
+        pq4.pop();
+    }
+    EXPECT_TRUE(pq4.empty());
+
+    // refilling after the heap ran dry reuses the padding slots
+    pq4.emplace(5);
+    pq4.push(3);
+    EXPECT_EQ(2, pq4.size());
+    EXPECT_EQ(3, pq4.top());
+
+    TinySTL::priority_queue<int, TinySTL::vector<int>, std::greater<int>, 8> pq8(vec.begin(), vec.end());
+    EXPECT_EQ(vec.size(), pq8.size());
+    pq8.decreaseKey(999, 2000);
+    EXPECT_EQ(2000, pq8.top());
+    pq8.pop();
+    for (int i = 998; i >= 0; i--) {
+        EXPECT_EQ(i, pq8.top());
+        pq8.pop();
+    }
+    EXPECT_TRUE(pq8.empty());
+}
+
+TEST(PriorityQueueTest, Duplicates) {
+    TinySTL::vector<int> vec;
+    for (int i = 0; i < 1000; i++) {
+        vec.push_back((i * 7919) % 257);
+    }
+
+    TinySTL::priority_queue<int> pq2(vec.begin(), vec.end());
+    TinySTL::priority_queue<int, TinySTL::vector<int>, std::less<int>, 3> pq3;
+    for (size_t i = 0; i < vec.size(); i++) {
+        pq3.push(vec[i]);
+    }
+    int last = -1;
+    while (!pq2.empty()) {
+        EXPECT_LE(last, pq2.top());
+        EXPECT_EQ(pq2.top(), pq3.top());
+        last = pq2.top();
+        pq2.pop();
+        pq3.pop();
+    }
+    EXPECT_TRUE(pq3.empty());
+    EXPECT_EQ(256, last);
+}
+
+TEST(PriorityQueueTest, Aligned) {
+    TinySTL::aligned_priority_queue<int> pq;
+    for (int i = 500; i > 0; i--) {
+        pq.push(i);
+    }
+    for (int i = 1; i <= 500; i++) {
+        EXPECT_EQ(i, pq.top());
+        pq.pop();
+    }
+    EXPECT_TRUE(pq.empty());
+
+    // too wide for two per cache line: binary heap
+    struct Wide {
+        long long key;
+        char payload[40];
+        bool operator<(const Wide& rhs) const { return key < rhs.key; }
+    };
+    TinySTL::aligned_priority_queue<Wide> wide;
+    for (int i = 50; i > 0; i--) {
+        wide.push(Wide{ i, {} });
+    }
+    for (int i = 1; i <= 50; i++) {
+        EXPECT_EQ(i, wide.top().key);
+        wide.pop();
+    }
+}
+
+TEST(PriorityQueueTest, PushRange) {
+    TinySTL::vector<int> vec;
+    for (int i = 0; i < 1000; i++) {
+        vec.push_back((i * 7919) % 1000);
+    }
+
+    // small batches sift up, the large one rebuilds
+    TinySTL::priority_queue<int, TinySTL::vector<int>, std::less<int>, 4> pq;
+    pq.push_range(vec.begin(), vec.begin() + 500);
+    pq.push_range(vec.begin() + 500, vec.begin() + 510);
+    pq.push_range(vec.begin() + 510, vec.end());
+    pq.push_range(vec.end(), vec.end());
+    EXPECT_EQ(vec.size(), pq.size());
+    for (int i = 0; i < 1000; i++) {
+        EXPECT_EQ(i, pq.top());
+        pq.pop();
+    }
+    EXPECT_TRUE(pq.empty());
+}
+
+TEST(PriorityQueueTest, Merge) {
+    TinySTL::priority_queue<int> evens, odds, empty;
+    for (int i = 0; i < 100; i++) {
+        evens.push(2 * i);
+        odds.push(2 * i + 1);
+    }
+    evens.merge(empty);
+    EXPECT_EQ(100, evens.size());
+    evens.merge(odds);
+    EXPECT_TRUE(odds.empty());
+    EXPECT_EQ(200, evens.size());
+    empty.merge(evens);
+    EXPECT_TRUE(evens.empty());
+    for (int i = 0; i < 200; i++) {
+        EXPECT_EQ(i, empty.top());
+        empty.pop();
+    }
+}
+
+TEST(PriorityQueueTest, PopN) {
+    TinySTL::vector<int> vec = { 5, 1, 4, 2, 3 };
+    TinySTL::priority_queue<int, TinySTL::vector<int>, std::greater<int>> pq(vec.begin(), vec.end());
+
+    int out[5];
+    int* end = pq.pop_n(2, out);
+    EXPECT_EQ(out + 2, end);
+    EXPECT_EQ(5, out[0]);
+    EXPECT_EQ(4, out[1]);
+    EXPECT_EQ(3, pq.size());
+
+    TinySTL::vector<int> rest;
+    pq.pop_n(10, std::back_inserter(rest));
+    EXPECT_TRUE(pq.empty());
+    EXPECT_EQ(3, rest.size());
+    EXPECT_EQ(3, rest[0]);
+    EXPECT_EQ(1, rest[2]);
+}
+
+TEST(PriorityQueueTest, Indexed) {
+    TinySTL::indexed_priority_queue<int> pq;
+    EXPECT_TRUE(pq.empty());
+
+    TinySTL::vector<size_t> handles;
+    for (int i = 0; i < 100; i++) {
+        handles.push_back(pq.push((i * 37) % 100));
+    }
+    EXPECT_EQ(100, pq.size());
+    EXPECT_EQ(0, pq.top());
+    EXPECT_EQ(handles[0], pq.top_handle());
+
+    // handle i holds (i * 37) % 100
+    EXPECT_TRUE(pq.contains(handles[3]));
+    EXPECT_EQ(11, pq.get(handles[3]));
+    pq.decreaseKey(handles[3], -5);
+    EXPECT_EQ(-5, pq.top());
+    EXPECT_EQ(handles[3], pq.top_handle());
+    pq.increaseKey(handles[3], 500);
+    EXPECT_EQ(0, pq.top());
+    pq.update(handles[5], -1);
+    EXPECT_EQ(-1, pq.top());
+    pq.update(handles[5], 85);
+
+    pq.erase(handles[0]);
+    EXPECT_FALSE(pq.contains(handles[0]));
+    EXPECT_EQ(99, pq.size());
+
+    int last = -1000;
+    size_t popped = 0;
+    while (!pq.empty()) {
+        EXPECT_LE(last, pq.top());
+        last = pq.top();
+        pq.pop();
+        popped++;
+    }
+    EXPECT_EQ(99, popped);
+    EXPECT_EQ(500, last);
+}
+
+TEST(PriorityQueueTest, IndexedExplicitHandles) {
+    TinySTL::indexed_priority_queue<double, TinySTL::vector<double>, std::greater<double>> pq;
+    pq.push(10, 1.0);
+    pq.push(3, 7.5);
+    pq.push(7, 4.0);
+    EXPECT_EQ(3, pq.top_handle());
+    EXPECT_FALSE(pq.contains(4));
+    EXPECT_FALSE(pq.contains(50));
+
+    pq.pop();
+    EXPECT_FALSE(pq.contains(3));
+    pq.push(3, 2.0);   // explicit reuse of a freed handle
+    size_t h = pq.push(9.0);
+    EXPECT_NE(3, h);
+    EXPECT_EQ(h, pq.top_handle());
+    pq.pop();
+    EXPECT_EQ(7, pq.top_handle());
+    pq.pop();
+    EXPECT_EQ(3, pq.top_handle());
+    pq.pop();
+    EXPECT_EQ(10, pq.top_handle());
+}